@@ -25,6 +25,13 @@ extern "C" {
 // Get GPIO hardware instance with giving gpio num
 #define GPIO_HAL_GET_HW(num) GPIO_LL_GET_HW(num)
 
+// Mascaras de los pines de cada lado de la tarjeta
+#define GPIO_HAL_LEFT_BANK_MASK  GPIO_LL_LEFT_BANK_MASK
+#define GPIO_HAL_RIGHT_BANK_MASK GPIO_LL_RIGHT_BANK_MASK
+#define GPIO_HAL_LEFT_BANK_OUTPUT_MASK  GPIO_LL_LEFT_BANK_OUTPUT_MASK
+#define GPIO_HAL_RIGHT_BANK_OUTPUT_MASK GPIO_LL_RIGHT_BANK_OUTPUT_MASK
+#define GPIO_HAL_RTC_IO_MASK            GPIO_LL_RTC_IO_MASK
+
 /**
  * Context that should be maintained by both the driver and the HAL
  */
@@ -35,118 +42,77 @@ typedef struct {
 } gpio_hal_context_t;
 
 /**************************************************************************
-* Function: gpio_hal_act_left_op
-* Preconditions: gpio_ll_act_left_op
-* Overview: Redefinicion de la activacion de salidas izquierdas.
-*
-*****************************************************************************/
-#define gpio_hal_act_left_op(hal) gpio_ll_act_left_op((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_deact_left_op
-* Preconditions: gpio_ll_deact_left_op
-* Overview: Redefinicion de la desactivacion de salidas izquierdas.
-*
-*****************************************************************************/
-#define gpio_hal_deact_left_op(hal) gpio_ll_deact_left_op((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_act_right_op
-* Preconditions: gpio_ll_act_right_op
-* Overview: Redefinicion de la activacion de salidas derechas.
-*
-*****************************************************************************/
-#define gpio_hal_act_right_op(hal) gpio_ll_act_right_op((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_deact_right_op
-* Preconditions: gpio_ll_deact_right_op
-* Overview: Redefinicion de la desactivacion de salidas derechas.
-*
-*****************************************************************************/
-#define gpio_hal_deact_right_op(hal) gpio_ll_deact_right_op((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_act_left_ip
-* Preconditions: gpio_ll_act_left_ip
-* Overview: Redefinicion de la activacion de entradas izquierdas.
-*
-*****************************************************************************/
-#define gpio_hal_act_left_ip(hal) gpio_ll_act_left_ip((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_deact_left_ip
-* Preconditions: gpio_ll_deact_left_ip
-* Overview: Redefinicion de la desactivacion de entradas izquierdas.
-*
-*****************************************************************************/
-#define gpio_hal_deact_left_ip(hal) gpio_ll_deact_left_ip((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_act_left__pulldown
-* Preconditions: gpio_ll_act_left_pulldown
-* Overview: Redefinicion de la activacion de resistencias de pulldown izquierdas.
-*
-*****************************************************************************/
-#define gpio_hal_act_left_pulldown(hal) gpio_ll_act_left_pulldown((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_deact_left_pulldown
-* Preconditions: gpio_ll_act_left_pulldown
-* Overview: Redefinicion de la desactivacion de resistencias de pulldown izquierdas.
-*
-*****************************************************************************/
-#define gpio_hal_deact_left_pulldown(hal) gpio_ll_deact_left_pulldown((hal)->dev)
-/**************************************************************************
-* Function: gpio_hal_act_left_pullup
-* Preconditions: gpio_ll_act_left_pullup
-* Overview: Redefinicion de la activacion de resistencias de pullup izquierdas.
+* Function: gpio_hal_output_enable_mask
+* Preconditions: gpio_ll_output_enable_mask
+* Overview: Redefinicion de la activacion como salida de todos los pines de una mascara.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_act_left_pullup(hal) gpio_ll_act_left_pullup((hal)->dev)
+#define gpio_hal_output_enable_mask(hal, mask) gpio_ll_output_enable_mask((hal)->dev, mask)
 /**************************************************************************
-* Function: gpio_hal_deact_left_pullup
-* Preconditions: gpio_ll_deact_left_pullup
-* Overview: Redefinicion de la desactivacion de resistencias de pullup izquierdas.
+* Function: gpio_hal_output_disable_mask
+* Preconditions: gpio_ll_output_disable_mask
+* Overview: Redefinicion de la desactivacion como salida de todos los pines de una mascara.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_deact_left_pullup(hal) gpio_ll_deact_left_pullup((hal)->dev)
-
+#define gpio_hal_output_disable_mask(hal, mask) gpio_ll_output_disable_mask((hal)->dev, mask)
 /**************************************************************************
-* Function: gpio_hal_act_right_ip
-* Preconditions: gpio_ll_act_right_ip
-* Overview: Redefinicion de la activacion de entradas derechas.
+* Function: gpio_hal_input_enable_mask
+* Preconditions: gpio_ll_input_enable_mask
+* Overview: Redefinicion de la activacion como entrada de todos los pines de una mascara.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_act_right_ip(hal) gpio_ll_act_right_ip((hal)->dev)
+#define gpio_hal_input_enable_mask(hal, mask) gpio_ll_input_enable_mask((hal)->dev, mask)
 /**************************************************************************
-* Function: gpio_hal_deact_right_ip
-* Preconditions: gpio_ll_deact_right_ip
-* Overview: Redefinicion de la desactivacion de entradas derechas.
+* Function: gpio_hal_input_disable_mask
+* Preconditions: gpio_ll_input_disable_mask
+* Overview: Redefinicion de la desactivacion como entrada de todos los pines de una mascara.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_deact_right_ip(hal) gpio_ll_deact_right_ip((hal)->dev)
+#define gpio_hal_input_disable_mask(hal, mask) gpio_ll_input_disable_mask((hal)->dev, mask)
 /**************************************************************************
-* Function: gpio_hal_act_right__pulldown
-* Preconditions: gpio_ll_act_right_pulldown
-* Overview: Redefinicion de la activacion de resistencias de pulldown derechas.
+* Function: gpio_hal_pullup_en_mask
+* Preconditions: gpio_ll_pullup_en_mask
+* Overview: Redefinicion de la activacion de resistencias de pullup de una mascara de pines.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_act_right_pulldown(hal) gpio_ll_act_right_pulldown((hal)->dev)
+#define gpio_hal_pullup_en_mask(hal, mask) gpio_ll_pullup_en_mask((hal)->dev, mask)
 /**************************************************************************
-* Function: gpio_hal_deact_right_pulldown
-* Preconditions: gpio_ll_act_right_pulldown
-* Overview: Redefinicion de la desactivacion de resistencias de pulldown derechas.
+* Function: gpio_hal_pullup_dis_mask
+* Preconditions: gpio_ll_pullup_dis_mask
+* Overview: Redefinicion de la desactivacion de resistencias de pullup de una mascara de pines.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_deact_right_pulldown(hal) gpio_ll_deact_right_pulldown((hal)->dev)
+#define gpio_hal_pullup_dis_mask(hal, mask) gpio_ll_pullup_dis_mask((hal)->dev, mask)
 /**************************************************************************
-* Function: gpio_hal_act_right_pullup
-* Preconditions: gpio_ll_act_right_pullup
-* Overview: Redefinicion de la activacion de resistencias de pullup derechas.
+* Function: gpio_hal_pulldown_en_mask
+* Preconditions: gpio_ll_pulldown_en_mask
+* Overview: Redefinicion de la activacion de resistencias de pulldown de una mascara de pines.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_act_right_pullup(hal) gpio_ll_act_right_pullup((hal)->dev)
+#define gpio_hal_pulldown_en_mask(hal, mask) gpio_ll_pulldown_en_mask((hal)->dev, mask)
 /**************************************************************************
-* Function: gpio_hal_deact_right_pullup
-* Preconditions: gpio_ll_deact_right_pullup
-* Overview: Redefinicion de la desactivacion de resistencias de pullup derechas.
+* Function: gpio_hal_pulldown_dis_mask
+* Preconditions: gpio_ll_pulldown_dis_mask
+* Overview: Redefinicion de la desactivacion de resistencias de pulldown de una mascara de pines.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
 *
 *****************************************************************************/
-#define gpio_hal_deact_right_pullup(hal) gpio_ll_deact_right_pullup((hal)->dev)
+#define gpio_hal_pulldown_dis_mask(hal, mask) gpio_ll_pulldown_dis_mask((hal)->dev, mask)
 
 /**************************************************************************
 * Function:gpio_hal_pullup_act
@@ -199,6 +165,17 @@ typedef struct {
 *****************************************************************************/
 #define gpio_hal_set_intr_type(hal, gpio_num, intr_type) gpio_ll_set_intr_type((hal)->dev, gpio_num, intr_type)
 
+/**************************************************************************
+* Function: gpio_hal_get_intr_type
+* Preconditions: gpio_ll_get_intr_type
+* Overview: Redefinicion de lectura del tipo de interrupcion de un pin.
+* Input: hal: Contexto de la capa HAL.
+* 		 gpio_num: Numero de GPIO
+* Output: Tipo de interrupcion
+*
+*****************************************************************************/
+#define gpio_hal_get_intr_type(hal, gpio_num) gpio_ll_get_intr_type((hal)->dev, gpio_num)
+
 /**************************************************************************
 * Function: gpio_hal_get_intr_status
 * Preconditions: gpio_ll_get_intr_status
@@ -232,6 +209,26 @@ typedef struct {
 #define gpio_hal_clear_intr_status_bit(hal, gpio_num) (((gpio_num) < 32) ? gpio_ll_clear_intr_status((hal)->dev, 1 << gpio_num) \
                                                                          : gpio_ll_clear_intr_status_high((hal)->dev, 1 << (gpio_num - 32)))
 
+/**************************************************************************
+* Function: gpio_hal_clear_intr_status
+* Preconditions: gpio_ll_clear_intr_status
+* Overview: Redefinicion de limpiar el estado de interrupcion de varios GPIO0-31 en una escritura.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de bits a limpiar (bit n = GPIO n)
+*
+*****************************************************************************/
+#define gpio_hal_clear_intr_status(hal, mask) gpio_ll_clear_intr_status((hal)->dev, mask)
+
+/**************************************************************************
+* Function: gpio_hal_clear_intr_status_high
+* Preconditions: gpio_ll_clear_intr_status_high
+* Overview: Redefinicion de limpiar el estado de interrupcion de varios GPIO32-39 en una escritura.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de bits a limpiar (bit n = GPIO 32+n)
+*
+*****************************************************************************/
+#define gpio_hal_clear_intr_status_high(hal, mask) gpio_ll_clear_intr_status_high((hal)->dev, mask)
+
 /**************************************************************************
 * Function: gpio_hal_intr_enable_on_core
 * Overview: Habilita la se?al de interrupcion del modulo GPIO.
@@ -291,6 +288,16 @@ void gpio_hal_intr_disable(gpio_hal_context_t *hal, uint32_t gpio_num);
 *****************************************************************************/
 #define gpio_hal_output_enable(hal, gpio_num) gpio_ll_output_enable((hal)->dev, gpio_num)
 
+/**************************************************************************
+* Function: gpio_hal_connect_gpio_out_mask
+* Preconditions: gpio_ll_connect_gpio_out_mask
+* Overview: Redefinicion de funcion para enrutar la salida simple de GPIO a todos los pines de una mascara.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines a enrutar.
+*
+*****************************************************************************/
+#define gpio_hal_connect_gpio_out_mask(hal, mask) gpio_ll_connect_gpio_out_mask((hal)->dev, mask)
+
 /**************************************************************************
 * Function: gpio_hal_od_disable
 * Preconditions: gpio_ll_od_disable
@@ -331,6 +338,37 @@ void gpio_hal_intr_disable(gpio_hal_context_t *hal, uint32_t gpio_num);
 *****************************************************************************/
 #define gpio_hal_set_level(hal, gpio_num, level) gpio_ll_set_level((hal)->dev, gpio_num, level)
 
+/**************************************************************************
+* Function: gpio_hal_set_mask
+* Preconditions: gpio_ll_set_mask
+* Overview: Redefinicion de funcion para poner en alto varias salidas de GPIO a la vez.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines a poner en alto.
+*
+*****************************************************************************/
+#define gpio_hal_set_mask(hal, mask) gpio_ll_set_mask((hal)->dev, mask)
+
+/**************************************************************************
+* Function: gpio_hal_clear_mask
+* Preconditions: gpio_ll_clear_mask
+* Overview: Redefinicion de funcion para poner en bajo varias salidas de GPIO a la vez.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines a poner en bajo.
+*
+*****************************************************************************/
+#define gpio_hal_clear_mask(hal, mask) gpio_ll_clear_mask((hal)->dev, mask)
+
+/**************************************************************************
+* Function: gpio_hal_write_mask
+* Preconditions: gpio_ll_write_mask
+* Overview: Redefinicion de funcion para escribir el nivel de varias salidas de GPIO a la vez.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines a modificar.
+* 		 values: Nivel deseado para cada pin de la mascara (un bit por pin).
+*
+*****************************************************************************/
+#define gpio_hal_write_mask(hal, mask, values) gpio_ll_write_mask((hal)->dev, mask, values)
+
 /**************************************************************************
 * Function: gpio_hal_get_level
 * Preconditions: gpio_ll_get_level
@@ -343,6 +381,86 @@ void gpio_hal_intr_disable(gpio_hal_context_t *hal, uint32_t gpio_num);
 *****************************************************************************/
 #define gpio_hal_get_level(hal, gpio_num) gpio_ll_get_level((hal)->dev, gpio_num)
 
+/**************************************************************************
+* Function: gpio_hal_get_levels
+* Preconditions: gpio_ll_get_levels
+* Overview: Redefinicion de funcion para leer el nivel de entrada de todos los GPIO en una sola lectura.
+* Input: hal: Contexto de la capa HAL.
+* Output: Nivel de entrada de todos los pines (bit n = GPIO n)
+*
+*****************************************************************************/
+#define gpio_hal_get_levels(hal) gpio_ll_get_levels((hal)->dev)
+
+/**************************************************************************
+* Function: gpio_hal_get_output_levels
+* Preconditions: gpio_ll_get_output_levels
+* Overview: Redefinicion de la lectura del nivel que se manda a todas las salidas.
+* Input: hal: Contexto de la capa HAL.
+*
+*****************************************************************************/
+#define gpio_hal_get_output_levels(hal) gpio_ll_get_output_levels((hal)->dev)
+
+/**************************************************************************
+* Function: gpio_hal_get_output_enable
+* Preconditions: gpio_ll_get_output_enable
+* Overview: Redefinicion de la lectura de los pines con salida habilitada.
+* Input: hal: Contexto de la capa HAL.
+*
+*****************************************************************************/
+#define gpio_hal_get_output_enable(hal) gpio_ll_get_output_enable((hal)->dev)
+
+/**************************************************************************
+* Function: gpio_hal_output_enable_clear_mask
+* Preconditions: gpio_ll_output_enable_clear_mask
+* Overview: Redefinicion de la limpieza de la habilitacion de salida sin tocar el enrutamiento.
+* Input: hal: Contexto de la capa HAL.
+* 		 mask: Mascara de 64 bits con los pines.
+*
+*****************************************************************************/
+#define gpio_hal_output_enable_clear_mask(hal, mask) gpio_ll_output_enable_clear_mask((hal)->dev, mask)
+
+/**************************************************************************
+* Function: gpio_hal_get_pin_config
+* Preconditions: gpio_ll_get_pin_config
+* Overview: Redefinicion de la lectura del registro GPIO_PINn.
+* Input: hal: Contexto de la capa HAL.
+* 		 gpio_num: Numero de GPIO.
+*
+*****************************************************************************/
+#define gpio_hal_get_pin_config(hal, gpio_num) gpio_ll_get_pin_config((hal)->dev, gpio_num)
+
+/**************************************************************************
+* Function: gpio_hal_set_pin_config
+* Preconditions: gpio_ll_set_pin_config
+* Overview: Redefinicion de la escritura del registro GPIO_PINn.
+* Input: hal: Contexto de la capa HAL.
+* 		 gpio_num: Numero de GPIO.
+* 		 val: Valor a escribir.
+*
+*****************************************************************************/
+#define gpio_hal_set_pin_config(hal, gpio_num, val) gpio_ll_set_pin_config((hal)->dev, gpio_num, val)
+
+/**************************************************************************
+* Function: gpio_hal_get_out_sel_config
+* Preconditions: gpio_ll_get_out_sel_config
+* Overview: Redefinicion de la lectura del enrutamiento de salida de un pin.
+* Input: hal: Contexto de la capa HAL.
+* 		 gpio_num: Numero de GPIO.
+*
+*****************************************************************************/
+#define gpio_hal_get_out_sel_config(hal, gpio_num) gpio_ll_get_out_sel_config((hal)->dev, gpio_num)
+
+/**************************************************************************
+* Function: gpio_hal_set_out_sel_config
+* Preconditions: gpio_ll_set_out_sel_config
+* Overview: Redefinicion de la escritura del enrutamiento de salida de un pin.
+* Input: hal: Contexto de la capa HAL.
+* 		 gpio_num: Numero de GPIO.
+* 		 val: Valor a escribir.
+*
+*****************************************************************************/
+#define gpio_hal_set_out_sel_config(hal, gpio_num, val) gpio_ll_set_out_sel_config((hal)->dev, gpio_num, val)
+
 /**************************************************************************
 * Function: gpio_hal_wakeup_enable
 * Preconditions: gpio_ll_wakeup_enable
@@ -689,6 +807,34 @@ void gpio_hal_sleep_pupd_config_unapply(gpio_hal_context_t *hal, uint32_t gpio_n
 *
 *****************************************************************************/
 #define gpio_hal_iomux_func_sel(pin_name, func) gpio_ll_iomux_func_sel(pin_name, func)
+/**************************************************************************
+* Function: gpio_hal_iomux_update
+* Preconditions: gpio_ll_iomux_update
+* Overview: Redefinicion de la modificacion de varios campos del registro IOMUX de un pin
+* 			en una sola escritura.
+* Input: pin_name: Registro IOMUX del pin.
+* 		 clr_bits: Bits a limpiar.
+* 		 set_bits: Bits a activar.
+*
+*****************************************************************************/
+#define gpio_hal_iomux_update(pin_name, clr_bits, set_bits) gpio_ll_iomux_update(pin_name, clr_bits, set_bits)
+/**************************************************************************
+* Function: gpio_hal_iomux_read
+* Preconditions: gpio_ll_iomux_read
+* Overview: Redefinicion de la lectura de la palabra de configuracion IOMUX de un pin.
+* Input: pin_name: Registro IOMUX del pin.
+*
+*****************************************************************************/
+#define gpio_hal_iomux_read(pin_name) gpio_ll_iomux_read(pin_name)
+/**************************************************************************
+* Function: gpio_hal_iomux_write
+* Preconditions: gpio_ll_iomux_write
+* Overview: Redefinicion de la escritura de la palabra de configuracion IOMUX de un pin.
+* Input: pin_name: Registro IOMUX del pin.
+* 		 val: Valor a escribir.
+*
+*****************************************************************************/
+#define gpio_hal_iomux_write(pin_name, val) gpio_ll_iomux_write(pin_name, val)
 
 #ifdef __cplusplus
 }
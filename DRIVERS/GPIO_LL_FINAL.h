@@ -39,444 +39,212 @@ extern const uint8_t GPIO_PIN_MUX_REG_OFFSET[SOC_GPIO_PIN_COUNT];
 #define GPIO_LL_PRO_CPU_NMI_INTR_ENA  (BIT(3))
 #define GPIO_LL_SDIO_EXT_INTR_ENA     (BIT(4))
 
+// Pines de cada lado fisico de la tarjeta ESP32, precalculados como mascara de 64 bits.
+// Se excluyen los numeros que no tienen pad en el chip (20, 24, 28-31), ya que su GPIO_PIN_MUX_REG es 0;
+// el 20 se quita a mano porque algunas versiones de SOC_GPIO_VALID_GPIO_MASK lo incluyen.
+#define GPIO_LL_LEFT_BANK_MASK  ((BIT64(3) | BIT64(4) | BIT64(5) | BIT64(6) | BIT64(7) | BIT64(8) | BIT64(9) | \
+                                  BIT64(10) | BIT64(11) | BIT64(12) | BIT64(13) | BIT64(15) | BIT64(16) | BIT64(17)) & \
+                                 SOC_GPIO_VALID_GPIO_MASK)
+#define GPIO_LL_RIGHT_BANK_MASK ((BIT64(21) | BIT64(22) | BIT64(23) | BIT64(24) | BIT64(25) | BIT64(26) | \
+                                  BIT64(27) | BIT64(28) | BIT64(29) | BIT64(30) | BIT64(31) | BIT64(33) | BIT64(34) | \
+                                  BIT64(35) | BIT64(36) | BIT64(37)) & SOC_GPIO_VALID_GPIO_MASK)
+// Pines de cada lado que pueden manejar salida: sin los de solo entrada (34-39) ni los que no
+// tienen pad. Son los unicos que se habilitan en enable/enable1 y se enrutan en func_out_sel_cfg.
+#define GPIO_LL_LEFT_BANK_OUTPUT_MASK  (GPIO_LL_LEFT_BANK_MASK & SOC_GPIO_VALID_OUTPUT_GPIO_MASK)
+#define GPIO_LL_RIGHT_BANK_OUTPUT_MASK (GPIO_LL_RIGHT_BANK_MASK & SOC_GPIO_VALID_OUTPUT_GPIO_MASK)
+// Pines que tambien son RTC_IO en el ESP32; sus resistencias de pull se manejan desde RTC_IO
+#define GPIO_LL_RTC_IO_MASK     (BIT64(0) | BIT64(2) | BIT64(4) | BIT64(12) | BIT64(13) | BIT64(14) | BIT64(15) | \
+                                 BIT64(25) | BIT64(26) | BIT64(27) | BIT64(32) | BIT64(33) | BIT64(34) | \
+                                 BIT64(35) | BIT64(36) | BIT64(37) | BIT64(38) | BIT64(39))
+
 /**************************************************************************
-* Function: gpio_ll_act_left_op
+* Function: gpio_ll_output_enable_mask
 * Preconditions:
-* Overview: En esta funcion se establecen como salidas todos los pines GPIO del lado izquierdo en la tarjeta ESP32.
-* Input:
-* Output:
-*
-*****************************************************************************/
-static inline void gpio_ll_act_left_op(gpio_dev_t *hw){
-	hw->enable_w1ts = (0x1 << 3);
-	hw->enable_w1ts = (0x1 << 4);
-	hw->enable_w1ts = (0x1 << 5);
-	hw->enable_w1ts = (0x1 << 6);
-	hw->enable_w1ts = (0x1 << 7);
-	hw->enable_w1ts = (0x1 << 8);
-	hw->enable_w1ts = (0x1 << 9);
-	hw->enable_w1ts = (0x1 << 10);
-	hw->enable_w1ts = (0x1 << 11);
-	hw->enable_w1ts = (0x1 << 12);
-	hw->enable_w1ts = (0x1 << 13);
-	hw->enable_w1ts = (0x1 << 15);
-	hw->enable_w1ts = (0x1 << 16);
-	hw->enable_w1ts = (0x1 << 17);
-	}
-/**************************************************************************
-* Function: gpio_ll_deact_left_op
-* Preconditions:
-* Overview: En esta funcion se destactivan todos los pines GPIO del lado izquierdo de la tarjeta ESP32 como salidas
-* Input:
+* Overview: Esta funcion habilita como salida todos los pines de la mascara con una sola escritura
+* 			en enable_w1ts y una en enable1_w1ts.
+* Input: Recibe la mascara de 64 bits con los pines a habilitar como salida
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_deact_left_op(gpio_dev_t *hw){
-	hw->enable_w1tc = (0x1 << 3);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (3 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 4);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (4 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 5);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (5 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 6);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (6 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 7);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (7 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 8);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (8 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 9);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (9 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 10);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (10 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 11);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (11 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 12);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (12 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 13);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (13 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 15);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (15 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 16);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (16 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 17);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (17 * 4), SIG_GPIO_OUT_IDX);
-	}
-/**************************************************************************
-* Function: gpio_ll_act_right_op
-* Preconditions:
-* Overview: En esta funcion se establecen como salidas todos los pines GPIO del lado derecho de la tarjeta ESP32
-* Input:
-* Output:
-*
-*****************************************************************************/
-static inline void gpio_ll_act_right_op(gpio_dev_t *hw){
-	hw->enable_w1ts = (0x1 << 37);
-	hw->enable_w1ts = (0x1 << 36);
-	hw->enable_w1ts = (0x1 << 35);
-	hw->enable_w1ts = (0x1 << 34);
-	hw->enable_w1ts = (0x1 << 33);
-	hw->enable_w1ts = (0x1 << 31);
-	hw->enable_w1ts = (0x1 << 30);
-	hw->enable_w1ts = (0x1 << 29);
-	hw->enable_w1ts = (0x1 << 28);
-	hw->enable_w1ts = (0x1 << 27);
-	hw->enable_w1ts = (0x1 << 26);
-	hw->enable_w1ts = (0x1 << 25);
-	hw->enable_w1ts = (0x1 << 24);
-	hw->enable_w1ts = (0x1 << 23);
-	hw->enable_w1ts = (0x1 << 22);
-	hw->enable_w1ts = (0x1 << 21);
-	hw->enable_w1ts = (0x1 << 20);
-}
-/**************************************************************************
-* Function: gpio_ll_deact_right_op
-* Preconditions:
-* Overview: Esta funcion se desactivan todos los pines GPIO del lado derecho de la tarjeta ESP32 como salidas
-* Input:
-* Output:
-*
-*****************************************************************************/
-static inline void gpio_ll_deact_right_op(gpio_dev_t *hw){
-	hw->enable_w1tc = (0x1 << 37);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (37 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 36);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (36 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 35);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (35 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 34);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (34 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 33);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (33 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 31);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (31 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 30);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (30 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 29);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (29 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 28);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (28 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 27);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (27 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 26);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (26 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 25);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (25 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 24);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (24 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 23);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (23 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 22);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (22 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 21);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (21 * 4), SIG_GPIO_OUT_IDX);
-	hw->enable_w1tc = (0x1 << 20);
-	REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (20 * 4), SIG_GPIO_OUT_IDX);
+__attribute__((always_inline))
+static inline void gpio_ll_output_enable_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    uint32_t mask_lo = (uint32_t)mask;
+    uint32_t mask_hi = (uint32_t)(mask >> 32);
 
+    if (mask_lo) {
+        hw->enable_w1ts = mask_lo;
+    }
+    if (mask_hi) {
+        HAL_FORCE_MODIFY_U32_REG_FIELD(hw->enable1_w1ts, data, mask_hi);
+    }
 }
 /**************************************************************************
-* Function: gpio_ll_act_left_ip
+* Function: gpio_ll_connect_gpio_out_mask
 * Preconditions:
-* Overview: En esta funcion se establecen todos los pines GPIO del lado izquierdo de la tarjeta ESP32 como entradas
-* Input:
+* Overview: Esta funcion enruta la senal de salida simple de GPIO (SIG_GPIO_OUT_IDX) a todos los
+* 			pines de la mascara a traves de la matriz GPIO. Solo se visitan los bits activos.
+* Input: Recibe la mascara de 64 bits con los pines a enrutar
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_act_left_ip(gpio_dev_t *hw){
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[3]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[4]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[5]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[6]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[7]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[8]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[9]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[10]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[11]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[12]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[13]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[15]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[16]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[17]);
+static inline void gpio_ll_connect_gpio_out_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        REG_WRITE(GPIO_FUNC0_OUT_SEL_CFG_REG + (gpio_num * 4), SIG_GPIO_OUT_IDX);
+    }
 }
 /**************************************************************************
-* Function: gpio_ll_deact_left_ip
+* Function: gpio_ll_output_enable_clear_mask
 * Preconditions:
-* Overview: En esta funcion se desactivan todos los pines GPIO del lado izquierdo de la tarjeta ESP32 como entradas
-* Input:
+* Overview: Esta funcion limpia la habilitacion de salida de los pines de la mascara con una sola
+* 			escritura en enable_w1tc y una en enable1_w1tc, sin tocar el enrutamiento de la matriz.
+* Input: Recibe la mascara de 64 bits con los pines
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_deact_left_ip(gpio_dev_t *hw){
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[3]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[4]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[5]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[6]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[7]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[8]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[9]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[10]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[11]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[12]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[13]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[15]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[16]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[17]);
+__attribute__((always_inline))
+static inline void gpio_ll_output_enable_clear_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    uint32_t mask_lo = (uint32_t)mask;
+    uint32_t mask_hi = (uint32_t)(mask >> 32);
+
+    if (mask_lo) {
+        hw->enable_w1tc = mask_lo;
+    }
+    if (mask_hi) {
+        HAL_FORCE_MODIFY_U32_REG_FIELD(hw->enable1_w1tc, data, mask_hi);
+    }
 }
 /**************************************************************************
-* Function: gpio_ll_act_left_pulldown
-* Preconditions:
-* Overview: En esta funcion se activa el pulldown para todos los pines GPIO del lado izquierdo de la tarjeta ESP32
-* Input:
+* Function: gpio_ll_output_disable_mask
+* Preconditions: gpio_ll_connect_gpio_out_mask
+* Overview: Esta funcion deshabilita como salida todos los pines de la mascara con una sola escritura
+* 			en enable_w1tc y una en enable1_w1tc, y se asegura de que ninguna otra senal quede
+* 			enrutada a esos pines.
+* Input: Recibe la mascara de 64 bits con los pines a deshabilitar como salida
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_act_left_pulldown(gpio_dev_t *hw){
-	REG_SET_BIT(GPIO_PIN_MUX_REG[3], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[4], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[5], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[6], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[7], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[8], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[9], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[10], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[11], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[12], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[13], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[15], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[16], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[17], FUN_PD);
+static inline void gpio_ll_output_disable_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    gpio_ll_output_enable_clear_mask(hw, mask);
+    gpio_ll_connect_gpio_out_mask(hw, mask);
 }
 /**************************************************************************
-* Function: gpio_ll_deact_left_pulldown
+* Function: gpio_ll_get_output_enable
 * Preconditions:
-* Overview: En esta funcion se desctiva el pulldown de todos los pines GPIO del lado izquierdo de la tarjeta ESP32
+* Overview: Esta funcion lee los registros enable y enable1 y devuelve que pines tienen la
+* 			salida habilitada.
 * Input:
-* Output:
+* Output: Mascara de 64 bits con los pines habilitados como salida (bit n = GPIO n)
 *
 *****************************************************************************/
-static inline void gpio_ll_deact_left_pulldown(gpio_dev_t *hw){
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[3], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[4], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[5], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[6], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[7], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[8], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[9], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[10], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[11], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[12], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[13], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[15], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[16], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[17], FUN_PD);
+__attribute__((always_inline))
+static inline uint64_t gpio_ll_get_output_enable(gpio_dev_t *hw)
+{
+    uint32_t en_lo = hw->enable;
+    uint32_t en_hi = HAL_FORCE_READ_U32_REG_FIELD(hw->enable1, data);
+    return ((uint64_t)en_hi << 32) | en_lo;
 }
 /**************************************************************************
-* Function: gpio_ll_act_left_pullup
+* Function: gpio_ll_input_enable_mask
 * Preconditions:
-* Overview: En esta funcion se activa el pullup para todos los pines GPIO del lado izquierdo de la tarjeta ESP32
-* Input:
+* Overview: Esta funcion habilita la entrada de todos los pines de la mascara. Solo se visitan los
+* 			bits activos, un registro IO_MUX por pin.
+* Input: Recibe la mascara de 64 bits con los pines a habilitar como entrada
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_act_left_pullup(gpio_dev_t *hw){
-	REG_SET_BIT(GPIO_PIN_MUX_REG[3], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[4], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[5], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[6], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[7], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[8], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[9], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[10], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[11], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[12], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[13], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[15], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[16], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[17], FUN_PU);
+static inline void gpio_ll_input_enable_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[gpio_num]);
+    }
 }
 /**************************************************************************
-* Function: gpio_ll_deact_left_pullup
+* Function: gpio_ll_input_disable_mask
 * Preconditions:
-* Overview: En esta funcion se desactiva el pullup en todos los pines GPIO del lado izquierdo de la tarjeta ESP32
-* Input:
+* Overview: Esta funcion deshabilita la entrada de todos los pines de la mascara.
+* Input: Recibe la mascara de 64 bits con los pines a deshabilitar como entrada
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_deact_left_pullup(gpio_dev_t *hw){
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[3], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[4], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[5], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[6], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[7], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[8], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[9], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[10], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[11], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[12], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[13], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[15], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[16], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[17], FUN_PU);
+static inline void gpio_ll_input_disable_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[gpio_num]);
+    }
 }
 /**************************************************************************
-* Function: gpio_ll_act_right_ip
+* Function: gpio_ll_pullup_en_mask
 * Preconditions:
-* Overview: En esta funcion se activan todos los pines GPIO del lado derecho de la tarjeta ESP32 como entradas
-* Input:
-* Output:
-*
-*****************************************************************************/
-static inline void gpio_ll_act_right_ip(gpio_dev_t *hw){
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[37]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[36]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[35]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[34]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[33]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[31]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[30]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[29]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[28]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[27]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[26]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[25]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[24]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[23]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[22]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[21]);
-	PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[20]);
-}
-/**************************************************************************
-* Function: gpio_ll_deact_right_ip
-* Preconditions:
-* Overview: En esta funcion se desactivan todos los pines GPIO del lado derecho de la tarjeta ESP32 como entradas
-* Input:
-* Output:
-*
-*****************************************************************************/
-static inline void gpio_ll_deact_right_ip(gpio_dev_t *hw){
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[37]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[36]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[35]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[34]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[33]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[31]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[30]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[29]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[28]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[27]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[26]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[25]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[24]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[23]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[22]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[21]);
-	PIN_INPUT_DISABLE(GPIO_PIN_MUX_REG[20]);
-}
-/**************************************************************************
-* Function: gpio_ll_act_right_pullup
-* Preconditions:
-* Overview: En esta funcion se activa el pullup para todos los pines GPIO del lado derecho de la tarjeta ESP32
-* Input:
+* Overview: Esta funcion activa el pullup de todos los pines de la mascara.
+* Input: Recibe la mascara de 64 bits con los pines a los que se activara el pullup
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_act_right_pullup(gpio_dev_t *hw){
-	REG_SET_BIT(GPIO_PIN_MUX_REG[37], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[36], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[35], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[34], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[33], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[31], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[29], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[28], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[27], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[26], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[25], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[24], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[23], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[22], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[21], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[20], FUN_PU);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[30], FUN_PU);
-}
-/**************************************************************************
-* Function: gpio_ll_deact_right_pullup
-* Preconditions:
-* Overview: En esta funcion se desactiva el pullup para todos los pines GPIO del lado derecho de la tarjeta ESP32
-* Input:
+static inline void gpio_ll_pullup_en_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        REG_SET_BIT(GPIO_PIN_MUX_REG[gpio_num], FUN_PU);
+    }
+}
+/**************************************************************************
+* Function: gpio_ll_pullup_dis_mask
+* Preconditions:
+* Overview: Esta funcion desactiva el pullup de todos los pines de la mascara.
+* Input: Recibe la mascara de 64 bits con los pines a los que se desactivara el pullup
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_deact_right_pullup(gpio_dev_t *hw){
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[37], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[36], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[35], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[34], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[33], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[31], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[30], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[29], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[28], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[27], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[26], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[25], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[24], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[23], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[22], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[21], FUN_PU);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[20], FUN_PU);
-}
-/**************************************************************************
-* Function: gpio_ll_act_right_pulldown
-* Preconditions:
-* Overview: En esta funcion se activa el pulldown para todos los pines GPIO del lado derecho de la tarjeta ESP32
-* Input:
+static inline void gpio_ll_pullup_dis_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        REG_CLR_BIT(GPIO_PIN_MUX_REG[gpio_num], FUN_PU);
+    }
+}
+/**************************************************************************
+* Function: gpio_ll_pulldown_en_mask
+* Preconditions:
+* Overview: Esta funcion activa el pulldown de todos los pines de la mascara.
+* Input: Recibe la mascara de 64 bits con los pines a los que se activara el pulldown
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_act_right_pulldown(gpio_dev_t *hw){
-	REG_SET_BIT(GPIO_PIN_MUX_REG[37], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[36], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[35], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[34], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[33], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[31], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[29], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[28], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[27], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[26], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[25], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[24], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[23], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[22], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[21], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[20], FUN_PD);
-	REG_SET_BIT(GPIO_PIN_MUX_REG[30], FUN_PD);}
-/**************************************************************************
-* Function: gpio_ll_deact_right_pulldown
-* Preconditions: ?
-* Overview: En esta funcion se desctiva el pulldown para todos los pines GPIO del lado derecho de la tarjeta ESP32
-* Input:
+static inline void gpio_ll_pulldown_en_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        REG_SET_BIT(GPIO_PIN_MUX_REG[gpio_num], FUN_PD);
+    }
+}
+/**************************************************************************
+* Function: gpio_ll_pulldown_dis_mask
+* Preconditions:
+* Overview: Esta funcion desactiva el pulldown de todos los pines de la mascara.
+* Input: Recibe la mascara de 64 bits con los pines a los que se desactivara el pulldown
 * Output:
 *
 *****************************************************************************/
-static inline void gpio_ll_deact_right_pulldown(gpio_dev_t *hw){
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[37], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[36], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[35], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[34], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[33], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[31], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[30], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[29], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[28], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[27], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[26], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[25], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[24], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[23], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[22], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[21], FUN_PD);
-	REG_CLR_BIT(GPIO_PIN_MUX_REG[20], FUN_PD);
+static inline void gpio_ll_pulldown_dis_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        REG_CLR_BIT(GPIO_PIN_MUX_REG[gpio_num], FUN_PD);
+    }
 }
 /**************************************************************************
 * Function: gpio_ll_pullup_act
@@ -677,6 +445,18 @@ static inline void gpio_ll_set_intr_type(gpio_dev_t *hw, uint32_t gpio_num, gpio
     hw->pin[gpio_num].int_type = intr_type;
 }
 /**************************************************************************
+* Function: gpio_ll_get_intr_type
+* Preconditions:
+* Overview: Esta funcion lee el tipo de interrupcion configurado en un pin GPIO
+* Input: Recibe el numero de pin
+* Output: Tipo de interrupcion del pin
+*
+*****************************************************************************/
+static inline gpio_int_type_t gpio_ll_get_intr_type(gpio_dev_t *hw, uint32_t gpio_num)
+{
+    return (gpio_int_type_t)hw->pin[gpio_num].int_type;
+}
+/**************************************************************************
 * Function: gpio_ll_get_intr_status
 * Preconditions:
 * Overview: Esta funcion se actualiza el estado de la interrupcion
@@ -946,6 +726,148 @@ static inline int gpio_ll_get_level(gpio_dev_t *hw, uint32_t gpio_num)
     }
 }
 /**************************************************************************
+* Function: gpio_ll_get_levels
+* Preconditions:
+* Overview: Esta funcion sirve para leer el nivel de entrada de todos los pines a la vez. Se leen
+* 			los registros in e in1 uno tras otro y se combinan en una sola palabra de 64 bits.
+* Input:
+* Output: Nivel de entrada de todos los pines (bit n = GPIO n)
+*
+*****************************************************************************/
+__attribute__((always_inline))
+static inline uint64_t gpio_ll_get_levels(gpio_dev_t *hw)
+{
+    uint32_t in_lo = hw->in;
+    uint32_t in_hi = HAL_FORCE_READ_U32_REG_FIELD(hw->in1, data);
+    return ((uint64_t)in_hi << 32) | in_lo;
+}
+/**************************************************************************
+* Function: gpio_ll_get_output_levels
+* Preconditions:
+* Overview: Esta funcion lee los registros out y out1, es decir el nivel que se esta mandando
+* 			a cada salida (no el nivel leido del pad).
+* Input:
+* Output: Nivel de salida de todos los pines (bit n = GPIO n)
+*
+*****************************************************************************/
+__attribute__((always_inline))
+static inline uint64_t gpio_ll_get_output_levels(gpio_dev_t *hw)
+{
+    uint32_t out_lo = hw->out;
+    uint32_t out_hi = HAL_FORCE_READ_U32_REG_FIELD(hw->out1, data);
+    return ((uint64_t)out_hi << 32) | out_lo;
+}
+/**************************************************************************
+* Function: gpio_ll_get_pin_config
+* Preconditions:
+* Overview: Esta funcion lee el registro GPIO_PINn completo (pad_driver, int_type, wakeup_enable,
+* 			int_ena).
+* Input: Recibe el numero de pin
+* Output: Valor del registro
+*
+*****************************************************************************/
+static inline uint32_t gpio_ll_get_pin_config(gpio_dev_t *hw, uint32_t gpio_num)
+{
+    return hw->pin[gpio_num].val;
+}
+/**************************************************************************
+* Function: gpio_ll_set_pin_config
+* Preconditions:
+* Overview: Esta funcion escribe el registro GPIO_PINn completo.
+* Input: Recibe el numero de pin y el valor a escribir
+* Output:
+*
+*****************************************************************************/
+static inline void gpio_ll_set_pin_config(gpio_dev_t *hw, uint32_t gpio_num, uint32_t val)
+{
+    hw->pin[gpio_num].val = val;
+}
+/**************************************************************************
+* Function: gpio_ll_get_out_sel_config
+* Preconditions:
+* Overview: Esta funcion lee el enrutamiento de salida de la matriz GPIO de un pin
+* 			(GPIO_FUNCn_OUT_SEL_CFG).
+* Input: Recibe el numero de pin
+* Output: Valor del registro
+*
+*****************************************************************************/
+static inline uint32_t gpio_ll_get_out_sel_config(gpio_dev_t *hw, uint32_t gpio_num)
+{
+    return hw->func_out_sel_cfg[gpio_num].val;
+}
+/**************************************************************************
+* Function: gpio_ll_set_out_sel_config
+* Preconditions:
+* Overview: Esta funcion escribe el enrutamiento de salida de la matriz GPIO de un pin.
+* Input: Recibe el numero de pin y el valor a escribir
+* Output:
+*
+*****************************************************************************/
+static inline void gpio_ll_set_out_sel_config(gpio_dev_t *hw, uint32_t gpio_num, uint32_t val)
+{
+    hw->func_out_sel_cfg[gpio_num].val = val;
+}
+/**************************************************************************
+* Function: gpio_ll_set_mask
+* Preconditions:
+* Overview: Esta funcion sirve para poner en alto todas las salidas indicadas en la mascara.
+* 			Se hace a lo mas una escritura en out_w1ts y una en out1_w1ts.
+* Input: Recibe la mascara de 64 bits con los pines a poner en alto
+* Output:
+*
+*****************************************************************************/
+__attribute__((always_inline))
+static inline void gpio_ll_set_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    uint32_t mask_lo = (uint32_t)mask;
+    uint32_t mask_hi = (uint32_t)(mask >> 32);
+
+    if (mask_lo) {
+        hw->out_w1ts = mask_lo;
+    }
+    if (mask_hi) {
+        HAL_FORCE_MODIFY_U32_REG_FIELD(hw->out1_w1ts, data, mask_hi);
+    }
+}
+/**************************************************************************
+* Function: gpio_ll_clear_mask
+* Preconditions:
+* Overview: Esta funcion sirve para poner en bajo todas las salidas indicadas en la mascara.
+* 			Se hace a lo mas una escritura en out_w1tc y una en out1_w1tc.
+* Input: Recibe la mascara de 64 bits con los pines a poner en bajo
+* Output:
+*
+*****************************************************************************/
+__attribute__((always_inline))
+static inline void gpio_ll_clear_mask(gpio_dev_t *hw, uint64_t mask)
+{
+    uint32_t mask_lo = (uint32_t)mask;
+    uint32_t mask_hi = (uint32_t)(mask >> 32);
+
+    if (mask_lo) {
+        hw->out_w1tc = mask_lo;
+    }
+    if (mask_hi) {
+        HAL_FORCE_MODIFY_U32_REG_FIELD(hw->out1_w1tc, data, mask_hi);
+    }
+}
+/**************************************************************************
+* Function: gpio_ll_write_mask
+* Preconditions: gpio_ll_set_mask, gpio_ll_clear_mask
+* Overview: Esta funcion sirve para escribir el nivel de varias salidas a la vez. Los pines de la
+* 			mascara cuyo bit en values es 1 se ponen en alto y el resto en bajo, con a lo mas
+* 			cuatro escrituras de registro.
+* Input: Recibe la mascara de pines a modificar y los niveles deseados (un bit por pin)
+* Output:
+*
+*****************************************************************************/
+__attribute__((always_inline))
+static inline void gpio_ll_write_mask(gpio_dev_t *hw, uint64_t mask, uint64_t values)
+{
+    gpio_ll_clear_mask(hw, mask & ~values);
+    gpio_ll_set_mask(hw, mask & values);
+}
+/**************************************************************************
 * Function: gpio_ll_wakeup_enable
 * Preconditions:
 * Overview: Esta funcion sirve para activar el wakeup en un pin a elegir
@@ -1113,6 +1035,45 @@ static inline __attribute__((always_inline)) void gpio_ll_iomux_func_sel(uint32_
     PIN_FUNC_SELECT(pin_name, func);
 }
 
+/**************************************************************************
+* Function: gpio_ll_iomux_update
+* Preconditions:
+* Overview: Esta funcion modifica varios campos del registro IOMUX de un pin con una sola
+* 			lectura-modificacion-escritura (entrada, pullup, pulldown, funcion...)
+* Input: Recibe el registro IOMUX del pin, los bits a limpiar y los bits a activar
+* Output:
+*
+*****************************************************************************/
+static inline __attribute__((always_inline)) void gpio_ll_iomux_update(uint32_t pin_name, uint32_t clr_bits, uint32_t set_bits)
+{
+    WRITE_PERI_REG(pin_name, (READ_PERI_REG(pin_name) & ~clr_bits) | set_bits);
+}
+
+/**************************************************************************
+* Function: gpio_ll_iomux_read
+* Preconditions:
+* Overview: Esta funcion lee la palabra completa de configuracion IOMUX de un pin
+* Input: Recibe el registro IOMUX del pin
+* Output: Valor del registro
+*
+*****************************************************************************/
+static inline __attribute__((always_inline)) uint32_t gpio_ll_iomux_read(uint32_t pin_name)
+{
+    return READ_PERI_REG(pin_name);
+}
+/**************************************************************************
+* Function: gpio_ll_iomux_write
+* Preconditions:
+* Overview: Esta funcion escribe la palabra completa de configuracion IOMUX de un pin
+* Input: Recibe el registro IOMUX del pin y el valor a escribir
+* Output:
+*
+*****************************************************************************/
+static inline __attribute__((always_inline)) void gpio_ll_iomux_write(uint32_t pin_name, uint32_t val)
+{
+    WRITE_PERI_REG(pin_name, val);
+}
+
 /**
  * @brief  Control the pin in the IOMUX
  *
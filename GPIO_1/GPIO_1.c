@@ -1,1980 +1,4778 @@
-/*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
- *
- * SPDX-License-Identifier: Apache-2.0
- */
-
-#include <esp_types.h>
-#include "esp_err.h"
-#include "freertos/FreeRTOS.h"
-#include "GPIO_1/INCLUDE/GPIO_1.h"
-#include "driver/rtc_io.h"
-#include "soc/soc.h"
-#include "soc/periph_defs.h"
-#if !CONFIG_FREERTOS_UNICORE
-#include "esp_ipc.h"
-#endif
-
-#include "soc/soc_caps.h"
-#include "soc/gpio_periph.h"
-#include "esp_log.h"
-#include "esp_check.h"
-#include "DRIVERS/GPIO_HAL_FINAL.h"
-#include "esp_rom_gpio.h"
-
-static const char *GPIO_TAG = "gpio";
-#define GPIO_CHECK(a, str, ret_val) ESP_RETURN_ON_FALSE(a, ret_val, GPIO_TAG, "%s", str)
-
-#define GPIO_ISR_CORE_ID_UNINIT    (3)
-
-//default value for SOC_GPIO_SUPPORT_RTC_INDEPENDENT is 0
-#ifndef SOC_GPIO_SUPPORT_RTC_INDEPENDENT
-#define SOC_GPIO_SUPPORT_RTC_INDEPENDENT 0
-#endif
-
-typedef struct {
-    gpio_isr_t fn;   /*!< isr function */
-    void *args;      /*!< isr function args */
-} gpio_isr_func_t;
-
-// Used by the IPC call to register the interrupt service routine.
-typedef struct {
-    int source;               /*!< ISR source */
-    int intr_alloc_flags;     /*!< ISR alloc flag */
-    void (*fn)(void*);        /*!< ISR function */
-    void *arg;                /*!< ISR function args*/
-    void *handle;             /*!< ISR handle */
-    esp_err_t ret;
-} gpio_isr_alloc_t;
-
-typedef struct {
-    gpio_hal_context_t *gpio_hal;
-    portMUX_TYPE gpio_spinlock;
-    uint32_t isr_core_id;
-    gpio_isr_func_t *gpio_isr_func;
-    gpio_isr_handle_t gpio_isr_handle;
-    uint64_t isr_clr_on_entry_mask; // for edge-triggered interrupts, interrupt status bits should be cleared before entering per-pin handlers
-} gpio_context_t;
-
-
-typedef struct {
-    uint64_t pin_bit_mask;          /*!<Pin GPIO: configurado con m?scara de bits, cada bit se asigna a un GPIO */
-    gpio_mode_t mode;               /*!< Modo GPIO: establece el modo de entrada/salida                     */
-    gpio_pullup_t pull_up_en;       /*!< GPIO pull-up                                         */
-    gpio_pulldown_t pull_down_en;   /*!< GPIO pull-down                                       */
-    gpio_int_type_t intr_type;      /*!< Tipo de interrupci?n GPIO                                 */
-} gpio_config_t;
-
-
-static gpio_hal_context_t _gpio_hal = {
-    .dev = GPIO_HAL_GET_HW(GPIO_PORT_0)
-};
-
-static gpio_context_t gpio_context = {
-    .gpio_hal = &_gpio_hal,
-    .gpio_spinlock = portMUX_INITIALIZER_UNLOCKED,
-    .isr_core_id = GPIO_ISR_CORE_ID_UNINIT,
-    .gpio_isr_func = NULL,
-    .isr_clr_on_entry_mask = 0,
-};
-/**************************************************************************
-* Function: gpio_set_output
-* Overview: Funcion que configura el pin seleccionado como salida.
-* Input: gpio_num.
-* Output: ret
-*
-*****************************************************************************/
-esp_err_t gpio_set_output(gpio_num_t gpio_num){
-	   GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-	    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (GPIO_MODE_DEF_OUTPUT)) {
-	        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
-	        return ESP_ERR_INVALID_ARG;
-	    }
-	    esp_err_t ret = ESP_OK;
-	    gpio_output_enable(gpio_num);
-	    return ret;
-}
-/**************************************************************************
-* Function: gpio_set_input_pullup
-* Overview: Funcion que configura el pin como entrada y activa el pullup.
-* Input: gpio_num.
-* Output: ret
-*
-*****************************************************************************/
-esp_err_t gpio_set_input_pullup(gpio_num_t gpio_num){
-	 GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-	    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (GPIO_MODE_DEF_INPUT & GPIO_MODE_DEF_OUTPUT)) {
-	        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
-	        return ESP_ERR_INVALID_ARG;
-	    }
-	    esp_err_t ret = ESP_OK;
-	    gpio_hal_input_enable(gpio_context.gpio_hal, gpio_num);
-
-	    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-	        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	        gpio_hal_pullup_en(gpio_context.gpio_hal, gpio_num);
-	        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	    } else {
-	#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-	        rtc_gpio_pullup_en(gpio_num);
-	#else
-	        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-	#endif
-	    }
-
-	    return ret;
-}
-/**************************************************************************
-* Function: gpio_set_input_pulldown
-* Overview: Funcion que habilita el pin seleccionado como entrada y activa el pulldown.
-* Input: gpio_num.
-* Output: ret
-*
-*****************************************************************************/
-esp_err_t gpio_set_input_pulldown(gpio_num_t gpio_num){
-	 GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-	    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (GPIO_MODE_DEF_INPUT & GPIO_MODE_DEF_OUTPUT)) {
-	        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
-	        return ESP_ERR_INVALID_ARG;
-	    }
-	    esp_err_t ret = ESP_OK;
-	    gpio_hal_input_enable(gpio_context.gpio_hal, gpio_num);
-
-	    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-	        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	        gpio_hal_pulldown_en(gpio_context.gpio_hal, gpio_num);
-	        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	    } else {
-	#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-	        rtc_gpio_pulldown_en(gpio_num);
-	#else
-	        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-	#endif
-	    }
-
-	    return ret;
-}
-/**************************************************************************
-* Function: gpio_set_input_isr
-* Overview: Funcion que configura el pin como entrada y permite configurar las interrupciones.
-* Input: gpio_num
-* 		 isr_type
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_set_input_isr(gpio_num_t gpio_num, gpio_int_type_t isr_type){
-	gpio_config_t pGPIOConfig;
-	pGPIOConfig.pin_bit_mask = (1ULL << gpio_num);
-	pGPIOConfig.mode = GPIO_MODE_DEF_INPUT;
-	pGPIOConfig.pull_up_en = GPIO_PULLUP_DISABLE;
-	pGPIOConfig.pull_down_en = GPIO_PULLDOWN_DISABLE;
-	pGPIOConfig.intr_type = isr_type;
-
-	gpio_config(&pGPIOConfig);
-
-	return ESP_OK;
-}
-
-/**************************************************************************
-* Function: gpio_act_left_op
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa las salidas del lado izquierdo del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_left_op(void){
-	gpio_hal_act_left_op(gpio_context.gpio_hal);
-	esp_rom_gpio_connect_out_signal(3, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(4, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(5, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(6, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(7, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(8, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(9, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(10, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(11, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(12, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(13, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(15, SIG_GPIO_OUT_IDX, false, false);
-    esp_rom_gpio_connect_out_signal(16, SIG_GPIO_OUT_IDX, false, false);
-    esp_rom_gpio_connect_out_signal(17, SIG_GPIO_OUT_IDX, false, false);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_left_op
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva los pines del lado izquierdo del chip como salidas.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_left_op(void){
-	gpio_hal_deact_left_op(gpio_context.gpio_hal);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_act_right_op
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa los pines del lado derecho del chip como salida.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_right_op(void){
-	gpio_hal_act_right_op(gpio_context.gpio_hal);
-	esp_rom_gpio_connect_out_signal(37, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(36, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(35, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(34, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(33, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(31, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(30, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(29, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(28, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(27, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(26, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(25, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(24, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(23, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(22, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(21, SIG_GPIO_OUT_IDX, false, false);
-	esp_rom_gpio_connect_out_signal(20, SIG_GPIO_OUT_IDX, false, false);
-	
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_right_op
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva las los pines del lado derecho del chip como salidas..
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_right_op(void){
-	gpio_hal_deact_right_op(gpio_context.gpio_hal);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_act_left_ip
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa los pines del lado izquierdo del chip como entradas.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_left_ip(void){
-	gpio_hal_act_left_ip(gpio_context.gpio_hal);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_left_ip
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva los pines del lado izquierdo del chip como entradas.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_left_ip(void){
-	gpio_hal_deact_left_ip(gpio_context.gpio_hal);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_act_right_ip
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa los pines del lado derecho del chip como entradas.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_right_ip(void){
-	gpio_hal_act_right_ip(gpio_context.gpio_hal);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_right_ip
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva los pines del lado derecho del chip como entradas.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_right_ip(void){
-	gpio_hal_deact_right_ip(gpio_context.gpio_hal);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_act_left_pulldown
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa las resistencias de pulldown del lado izquierdo del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_left_pulldown(void){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_act_left_pulldown(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_left_pulldown
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva las resistencias de pulldown del lado izquierdo del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_left_pulldown(void){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_deact_left_pulldown(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_act_right_pulldown
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa las resistencias de pulldown del lado derecho del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_right_pulldown(void){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_act_right_pulldown(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_right_pulldown
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva las resistencias de pulldown del lado derecho del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_right_pulldown(void){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_deact_right_pulldown(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_act_left_pullup
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa las resistencias de pullup del lado izquierdo del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_left_pullup(void){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_act_left_pullup(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_left_pullup
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva las resistencias de pullup del lado izquierdo del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_left_pullup(void){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_deact_left_pullup(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_act_right_pullup
-* Preconditions: gpio_context_t
-* Overview: Funcion que activa las resistencias de pullup del lado derecho del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_act_right_pullup(void){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_act_right_pullup(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_deact_right_pullup
-* Preconditions: gpio_context_t
-* Overview: Funcion que desactiva las resistencias de pullup del lado derecho del chip.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_deact_right_pullup(){
-	portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-	gpio_hal_deact_right_pullup(gpio_context.gpio_hal);
-	portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_reset_right
-* Overview: Funcion que resetea los pines del lado derecho del chip a su estado default.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_reset_right(void){
-	assert(1);
-    gpio_config_t cfg_37 = {
-        .pin_bit_mask = BIT64(37),
-        .mode = GPIO_MODE_DISABLE,
-        //Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_37);
-    gpio_config_t cfg_36 = {
-        .pin_bit_mask = BIT64(36),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_36);
-    gpio_config_t cfg_35 = {
-        .pin_bit_mask = BIT64(35),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_35);
-    gpio_config_t cfg_34 = {
-        .pin_bit_mask = BIT64(34),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_34);
-    gpio_config_t cfg_33 = {
-        .pin_bit_mask = BIT64(33),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_33);
-    gpio_config_t cfg_31 = {
-        .pin_bit_mask = BIT64(31),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_31);
-    gpio_config_t cfg_30 = {
-        .pin_bit_mask = BIT64(30),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_30);
-    gpio_config_t cfg_29 = {
-        .pin_bit_mask = BIT64(29),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_29);
-    gpio_config_t cfg_28 = {
-        .pin_bit_mask = BIT64(28),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_28);
-    gpio_config_t cfg_27 = {
-        .pin_bit_mask = BIT64(27),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_27);
-    gpio_config_t cfg_26 = {
-        .pin_bit_mask = BIT64(26),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_26);
-    gpio_config_t cfg_25 = {
-        .pin_bit_mask = BIT64(25),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_25);
-    gpio_config_t cfg_24 = {
-        .pin_bit_mask = BIT64(24),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_24);
-        gpio_config_t cfg_23 = {
-        .pin_bit_mask = BIT64(23),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_23);
-        gpio_config_t cfg_22 = {
-        .pin_bit_mask = BIT64(22),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_22);
-        gpio_config_t cfg_21 = {
-        .pin_bit_mask = BIT64(21),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_21);
-        gpio_config_t cfg_20 = {
-        .pin_bit_mask = BIT64(20),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_20);
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: gpio_reset_izquierdo
-* Overview: Funcion que resetea los pines del lado izquierdo del chip a su estado default.
-* Output: ESP_OK
-*
-*****************************************************************************/
-esp_err_t gpio_reset_left(void){
-	assert(1);
-    gpio_config_t cfg_3 = {
-        .pin_bit_mask = BIT64(3),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_3);
-    gpio_config_t cfg_4 = {
-        .pin_bit_mask = BIT64(4),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_4);
-    gpio_config_t cfg_5 = {
-        .pin_bit_mask = BIT64(5),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_5);
-    gpio_config_t cfg_6 = {
-        .pin_bit_mask = BIT64(6),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_6);
-    gpio_config_t cfg_7 = {
-        .pin_bit_mask = BIT64(7),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_7);
-    gpio_config_t cfg_8 = {
-        .pin_bit_mask = BIT64(8),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_8);
-    gpio_config_t cfg_9 = {
-        .pin_bit_mask = BIT64(9),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_9);
-    gpio_config_t cfg_10 = {
-        .pin_bit_mask = BIT64(10),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_10);
-    gpio_config_t cfg_11 = {
-        .pin_bit_mask = BIT64(11),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_11);
-    gpio_config_t cfg_12 = {
-        .pin_bit_mask = BIT64(12),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_12);
-    gpio_config_t cfg_13 = {
-        .pin_bit_mask = BIT64(13),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_13);
-    gpio_config_t cfg_15 = {
-        .pin_bit_mask = BIT64(15),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_15);
-    gpio_config_t cfg_16 = {
-        .pin_bit_mask = BIT64(16),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_16);
-
-gpio_config_t cfg_17 = {
-        .pin_bit_mask = BIT64(17),
-        .mode = GPIO_MODE_DISABLE,
-		//Por razones de ahorro de energia, el GPIO no deberia estar flotando, se selecciona pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg_17);
-
-	return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_pullup_en(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_pullup_en(gpio_context.gpio_hal, gpio_num);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-        rtc_gpio_pullup_en(gpio_num);
-#else
-        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-#endif
-    }
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_pullup_dis(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_pullup_dis(gpio_context.gpio_hal, gpio_num);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-        rtc_gpio_pullup_dis(gpio_num);
-#else
-        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-#endif
-    }
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_pulldown_en(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_pulldown_en(gpio_context.gpio_hal, gpio_num);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-        rtc_gpio_pulldown_en(gpio_num);
-#else
-        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-#endif
-    }
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_pulldown_dis(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_pulldown_dis(gpio_context.gpio_hal, gpio_num);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-        rtc_gpio_pulldown_dis(gpio_num);
-#else
-        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-#endif
-    }
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    GPIO_CHECK(intr_type < GPIO_INTR_MAX, "GPIO interrupt type error", ESP_ERR_INVALID_ARG);
-
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_set_intr_type(gpio_context.gpio_hal, gpio_num, intr_type);
-    if (intr_type == GPIO_INTR_POSEDGE || intr_type == GPIO_INTR_NEGEDGE || intr_type == GPIO_INTR_ANYEDGE) {
-        gpio_context.isr_clr_on_entry_mask |= (1ULL << (gpio_num));
-    } else {
-        gpio_context.isr_clr_on_entry_mask &= ~(1ULL << (gpio_num));
-    }
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return ESP_OK;
-}
-
-static esp_err_t gpio_intr_enable_on_core(gpio_num_t gpio_num, uint32_t core_id)
-{
-    gpio_hal_intr_enable_on_core(gpio_context.gpio_hal, gpio_num, core_id);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_intr_enable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    if(gpio_context.isr_core_id == GPIO_ISR_CORE_ID_UNINIT) {
-        gpio_context.isr_core_id = xPortGetCoreID();
-    }
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return gpio_intr_enable_on_core (gpio_num, gpio_context.isr_core_id);
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_intr_disable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_input_disable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_input_disable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_input_enable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_input_enable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_output_disable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_output_disable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_output_enable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO output gpio_num error", ESP_ERR_INVALID_ARG);
-    gpio_hal_output_enable(gpio_context.gpio_hal, gpio_num);
-    esp_rom_gpio_connect_out_signal(gpio_num, SIG_GPIO_OUT_IDX, false, false);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_od_disable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_od_disable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_od_enable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_od_enable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
-{
-    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO output gpio_num error", ESP_ERR_INVALID_ARG);
-    gpio_hal_set_level(gpio_context.gpio_hal, gpio_num, level);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-int gpio_get_level(gpio_num_t gpio_num)
-{
-    return gpio_hal_get_level(gpio_context.gpio_hal, gpio_num);
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    GPIO_CHECK(pull <= GPIO_FLOATING, "GPIO pull mode error", ESP_ERR_INVALID_ARG);
-    esp_err_t ret = ESP_OK;
-
-    switch (pull) {
-        case GPIO_PULLUP_ONLY:
-            gpio_pulldown_dis(gpio_num);
-            gpio_pullup_en(gpio_num);
-            break;
-
-        case GPIO_PULLDOWN_ONLY:
-            gpio_pulldown_en(gpio_num);
-            gpio_pullup_dis(gpio_num);
-            break;
-
-        case GPIO_PULLUP_PULLDOWN:
-            gpio_pulldown_en(gpio_num);
-            gpio_pullup_en(gpio_num);
-            break;
-
-        case GPIO_FLOATING:
-            gpio_pulldown_dis(gpio_num);
-            gpio_pullup_dis(gpio_num);
-            break;
-
-        default:
-            ESP_LOGE(GPIO_TAG, "Unknown pull up/down mode,gpio_num=%u,pull=%u", gpio_num, pull);
-            ret = ESP_ERR_INVALID_ARG;
-            break;
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (mode & GPIO_MODE_DEF_OUTPUT)) {
-        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    esp_err_t ret = ESP_OK;
-
-    if (mode & GPIO_MODE_DEF_INPUT) {
-        gpio_input_enable(gpio_num);
-    } else {
-        gpio_input_disable(gpio_num);
-    }
-
-    if (mode & GPIO_MODE_DEF_OUTPUT) {
-        gpio_output_enable(gpio_num);
-    } else {
-        gpio_output_disable(gpio_num);
-    }
-
-    if (mode & GPIO_MODE_DEF_OD) {
-        gpio_od_enable(gpio_num);
-    } else {
-        gpio_od_disable(gpio_num);
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_config(const gpio_config_t *pGPIOConfig)
-{
-    uint64_t gpio_pin_mask = (pGPIOConfig->pin_bit_mask);
-    uint32_t io_reg = 0;
-    uint32_t io_num = 0;
-    uint8_t input_en = 0;
-    uint8_t output_en = 0;
-    uint8_t od_en = 0;
-    uint8_t pu_en = 0;
-    uint8_t pd_en = 0;
-
-    if (pGPIOConfig->pin_bit_mask == 0 ||
-        pGPIOConfig->pin_bit_mask & ~SOC_GPIO_VALID_GPIO_MASK) {
-        ESP_LOGE(GPIO_TAG, "GPIO_PIN mask error ");
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    if (pGPIOConfig->mode & GPIO_MODE_DEF_OUTPUT &&
-        pGPIOConfig->pin_bit_mask & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK) {
-        ESP_LOGE(GPIO_TAG, "GPIO can only be used as input mode");
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    do {
-        io_reg = GPIO_PIN_MUX_REG[io_num];
-
-        if (((gpio_pin_mask >> io_num) & BIT(0))) {
-            assert(io_reg != (intptr_t)NULL);
-
-#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-            if (rtc_gpio_is_valid_gpio(io_num)) {
-                rtc_gpio_deinit(io_num);
-            }
-#endif
-
-            if ((pGPIOConfig->mode) & GPIO_MODE_DEF_INPUT) {
-                input_en = 1;
-                gpio_input_enable(io_num);
-            } else {
-                gpio_input_disable(io_num);
-            }
-
-            if ((pGPIOConfig->mode) & GPIO_MODE_DEF_OD) {
-                od_en = 1;
-                gpio_od_enable(io_num);
-            } else {
-                gpio_od_disable(io_num);
-            }
-
-            if ((pGPIOConfig->mode) & GPIO_MODE_DEF_OUTPUT) {
-                output_en = 1;
-                gpio_output_enable(io_num);
-            } else {
-                gpio_output_disable(io_num);
-            }
-
-            if (pGPIOConfig->pull_up_en) {
-                pu_en = 1;
-                gpio_pullup_en(io_num);
-            } else {
-                gpio_pullup_dis(io_num);
-            }
-
-            if (pGPIOConfig->pull_down_en) {
-                pd_en = 1;
-                gpio_pulldown_en(io_num);
-            } else {
-                gpio_pulldown_dis(io_num);
-            }
-
-            ESP_LOGI(GPIO_TAG, "GPIO[%"PRIu32"]| InputEn: %d| OutputEn: %d| OpenDrain: %d| Pullup: %d| Pulldown: %d| Intr:%d ", io_num, input_en, output_en, od_en, pu_en, pd_en, pGPIOConfig->intr_type);
-            gpio_set_intr_type(io_num, pGPIOConfig->intr_type);
-
-            if (pGPIOConfig->intr_type) {
-                gpio_intr_enable(io_num);
-            } else {
-                gpio_intr_disable(io_num);
-            }
-
-            /* By default, all the pins have to be configured as GPIO pins. */
-            gpio_hal_iomux_func_sel(io_reg, PIN_FUNC_GPIO);
-        }
-
-        io_num++;
-    } while (io_num < GPIO_PIN_COUNT);
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
-{
-    assert(GPIO_IS_VALID_GPIO(gpio_num));
-    gpio_config_t cfg = {
-        .pin_bit_mask = BIT64(gpio_num),
-        .mode = GPIO_MODE_DISABLE,
-        //for powersave reasons, the GPIO should not be floating, select pullup
-        .pull_up_en = true,
-        .pull_down_en = false,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&cfg);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static inline void IRAM_ATTR gpio_isr_loop(uint32_t status, const uint32_t gpio_num_start)
-{
-    while (status) {
-        int nbit = __builtin_ffs(status) - 1;
-        status &= ~(1 << nbit);
-        int gpio_num = gpio_num_start + nbit;
-
-        bool intr_status_bit_cleared = false;
-        // Edge-triggered type interrupt can clear the interrupt status bit before entering per-pin interrupt handler
-        if ((1ULL << (gpio_num)) & gpio_context.isr_clr_on_entry_mask) {
-            intr_status_bit_cleared = true;
-            gpio_hal_clear_intr_status_bit(gpio_context.gpio_hal, gpio_num);
-        }
-
-        if (gpio_context.gpio_isr_func[gpio_num].fn != NULL) {
-            gpio_context.gpio_isr_func[gpio_num].fn(gpio_context.gpio_isr_func[gpio_num].args);
-        }
-
-        // If the interrupt status bit was not cleared at the entry, then must clear it before exiting
-        if (!intr_status_bit_cleared) {
-            gpio_hal_clear_intr_status_bit(gpio_context.gpio_hal, gpio_num);
-        }
-    }
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static void IRAM_ATTR gpio_intr_service(void *arg)
-{
-    //GPIO intr process
-    if (gpio_context.gpio_isr_func == NULL) {
-        return;
-    }
-
-    //read status to get interrupt status for GPIO0-31
-    uint32_t gpio_intr_status;
-    gpio_hal_get_intr_status(gpio_context.gpio_hal, gpio_context.isr_core_id, &gpio_intr_status);
-
-    if (gpio_intr_status) {
-        gpio_isr_loop(gpio_intr_status, 0);
-    }
-
-    //read status1 to get interrupt status for GPIO32-39
-    uint32_t gpio_intr_status_h;
-    gpio_hal_get_intr_status_high(gpio_context.gpio_hal, gpio_context.isr_core_id, &gpio_intr_status_h);
-
-    if (gpio_intr_status_h) {
-        gpio_isr_loop(gpio_intr_status_h, 32);
-    }
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_install_isr_service(int intr_alloc_flags)
-{
-    GPIO_CHECK(gpio_context.gpio_isr_func == NULL, "GPIO isr service already installed", ESP_ERR_INVALID_STATE);
-    esp_err_t ret;
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_context.gpio_isr_func = (gpio_isr_func_t *) calloc(GPIO_NUM_MAX, sizeof(gpio_isr_func_t));
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    if (gpio_context.gpio_isr_func == NULL) {
-        ret = ESP_ERR_NO_MEM;
-    } else {
-        ret = gpio_isr_register(gpio_intr_service, NULL, intr_alloc_flags, &gpio_context.gpio_isr_handle);
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
-{
-    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_intr_disable(gpio_num);
-    if (gpio_context.gpio_isr_func) {
-        gpio_context.gpio_isr_func[gpio_num].fn = isr_handler;
-        gpio_context.gpio_isr_func[gpio_num].args = args;
-    }
-    gpio_intr_enable_on_core (gpio_num, esp_intr_get_cpu(gpio_context.gpio_isr_handle));
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_intr_disable(gpio_num);
-    if (gpio_context.gpio_isr_func) {
-        gpio_context.gpio_isr_func[gpio_num].fn = NULL;
-        gpio_context.gpio_isr_func[gpio_num].args = NULL;
-    }
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-void gpio_uninstall_isr_service(void)
-{
-    gpio_isr_func_t *gpio_isr_func_free = NULL;
-    gpio_isr_handle_t gpio_isr_handle_free = NULL;
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    if (gpio_context.gpio_isr_func == NULL) {
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-        return;
-    }
-    gpio_isr_func_free = gpio_context.gpio_isr_func;
-    gpio_context.gpio_isr_func = NULL;
-    gpio_isr_handle_free = gpio_context.gpio_isr_handle;
-    gpio_context.gpio_isr_handle = NULL;
-    gpio_context.isr_core_id = GPIO_ISR_CORE_ID_UNINIT;
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    esp_intr_free(gpio_isr_handle_free);
-    free(gpio_isr_func_free);
-    return;
-}
-
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static void gpio_isr_register_on_core_static(void *param)
-{
-    gpio_isr_alloc_t *p = (gpio_isr_alloc_t *)param;
-    //We need to check the return value.
-    p->ret = esp_intr_alloc(p->source, p->intr_alloc_flags, p->fn, p->arg, p->handle);
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_isr_register(void (*fn)(void *), void *arg, int intr_alloc_flags, gpio_isr_handle_t *handle)
-{
-    GPIO_CHECK(fn, "GPIO ISR null", ESP_ERR_INVALID_ARG);
-    gpio_isr_alloc_t p;
-    p.source = ETS_GPIO_INTR_SOURCE;
-    p.intr_alloc_flags = intr_alloc_flags;
-    p.fn = fn;
-    p.arg = arg;
-    p.handle = handle;
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    if(gpio_context.isr_core_id == GPIO_ISR_CORE_ID_UNINIT) {
-        gpio_context.isr_core_id = xPortGetCoreID();
-    }
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    esp_err_t ret;
-#if CONFIG_FREERTOS_UNICORE
-    gpio_isr_register_on_core_static(&p);
-    ret = ESP_OK;
-#else /* CONFIG_FREERTOS_UNICORE */
-    ret = esp_ipc_call_blocking(gpio_context.isr_core_id, gpio_isr_register_on_core_static, (void *)&p);
-#endif /* !CONFIG_FREERTOS_UNICORE */
-    if (ret != ESP_OK) {
-        ESP_LOGE(GPIO_TAG, "esp_ipc_call_blocking failed (0x%x)", ret);
-        return ESP_ERR_NOT_FOUND;
-    }
-    if (p.ret != ESP_OK) {
-        ESP_LOGE(GPIO_TAG, "esp_intr_alloc failed (0x%x)", p.ret);
-        return ESP_ERR_NOT_FOUND;
-    }
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    esp_err_t ret = ESP_OK;
-
-    if ((intr_type == GPIO_INTR_LOW_LEVEL) || (intr_type == GPIO_INTR_HIGH_LEVEL)) {
-#if SOC_RTCIO_WAKE_SUPPORTED
-        if (rtc_gpio_is_valid_gpio(gpio_num)) {
-            ret = rtc_gpio_wakeup_enable(gpio_num, intr_type);
-        }
-#endif
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_set_intr_type(gpio_context.gpio_hal, gpio_num, intr_type);
-        gpio_hal_wakeup_enable(gpio_context.gpio_hal, gpio_num);
-#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
-        gpio_hal_sleep_sel_dis(gpio_context.gpio_hal, gpio_num);
-#endif
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-        ESP_LOGE(GPIO_TAG, "GPIO wakeup only supports level mode, but edge mode set. gpio_num:%u", gpio_num);
-        ret = ESP_ERR_INVALID_ARG;
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    esp_err_t ret = ESP_OK;
-#if SOC_RTCIO_WAKE_SUPPORTED
-    if (rtc_gpio_is_valid_gpio(gpio_num)) {
-        ret = rtc_gpio_wakeup_disable(gpio_num);
-    }
-#endif
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_wakeup_disable(gpio_context.gpio_hal, gpio_num);
-#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
-    gpio_hal_sleep_sel_en(gpio_context.gpio_hal, gpio_num);
-#endif
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_set_drive_capability(gpio_num_t gpio_num, gpio_drive_cap_t strength)
-{
-    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    GPIO_CHECK(strength < GPIO_DRIVE_CAP_MAX, "GPIO drive capability error", ESP_ERR_INVALID_ARG);
-    esp_err_t ret = ESP_OK;
-
-    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_set_drive_capability(gpio_context.gpio_hal, gpio_num, strength);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-        ret = rtc_gpio_set_drive_capability(gpio_num, strength);
-#else
-        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-#endif
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_get_drive_capability(gpio_num_t gpio_num, gpio_drive_cap_t *strength)
-{
-    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    GPIO_CHECK(strength != NULL, "GPIO drive capability pointer error", ESP_ERR_INVALID_ARG);
-    esp_err_t ret = ESP_OK;
-
-    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_get_drive_capability(gpio_context.gpio_hal, gpio_num, strength);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
-        ret = rtc_gpio_get_drive_capability(gpio_num, strength);
-#else
-        abort(); // This should be eliminated as unreachable, unless a programming error has occured
-#endif
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_hold_en(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "Only output-capable GPIO support this function", ESP_ERR_NOT_SUPPORTED);
-    int ret = ESP_OK;
-
-    if (rtc_gpio_is_valid_gpio(gpio_num)) {
-#if SOC_RTCIO_HOLD_SUPPORTED
-        ret = rtc_gpio_hold_en(gpio_num);
-#endif
-    } else if (GPIO_HOLD_MASK[gpio_num]) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_hold_en(gpio_context.gpio_hal, gpio_num);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-        ret = ESP_ERR_NOT_SUPPORTED;
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_hold_dis(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "Only output-capable GPIO support this function", ESP_ERR_NOT_SUPPORTED);
-    int ret = ESP_OK;
-
-    if (rtc_gpio_is_valid_gpio(gpio_num)) {
-#if SOC_RTCIO_HOLD_SUPPORTED
-        ret = rtc_gpio_hold_dis(gpio_num);
-#endif
-    }else if (GPIO_HOLD_MASK[gpio_num]) {
-        portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-        gpio_hal_hold_dis(gpio_context.gpio_hal, gpio_num);
-        portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    } else {
-        ret = ESP_ERR_NOT_SUPPORTED;
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-void gpio_deep_sleep_hold_en(void)
-{
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_deep_sleep_hold_en(gpio_context.gpio_hal);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-void gpio_deep_sleep_hold_dis(void)
-{
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_deep_sleep_hold_dis(gpio_context.gpio_hal);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-}
-
-#if SOC_GPIO_SUPPORT_FORCE_HOLD
-
-esp_err_t IRAM_ATTR gpio_force_hold_all()
-{
-#if SOC_RTCIO_HOLD_SUPPORTED
-    rtc_gpio_force_hold_en_all();
-#endif
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_force_hold_all();
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return ESP_OK;
-}
-
-esp_err_t IRAM_ATTR gpio_force_unhold_all()
-{
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_force_unhold_all();
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-#if SOC_RTCIO_HOLD_SUPPORTED
-    rtc_gpio_force_hold_dis_all();
-#endif
-    return ESP_OK;
-}
-#endif
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-void gpio_iomux_in(uint32_t gpio, uint32_t signal_idx)
-{
-    gpio_hal_iomux_in(gpio_context.gpio_hal, gpio, signal_idx);
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-void gpio_iomux_out(uint8_t gpio_num, int func, bool oen_inv)
-{
-    gpio_hal_iomux_out(gpio_context.gpio_hal, gpio_num, func, (uint32_t)oen_inv);
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_pullup_en(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_sleep_pullup_en(gpio_context.gpio_hal, gpio_num);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_pullup_dis(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_sleep_pullup_dis(gpio_context.gpio_hal, gpio_num);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_pulldown_en(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_sleep_pulldown_en(gpio_context.gpio_hal, gpio_num);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_pulldown_dis(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_sleep_pulldown_dis(gpio_context.gpio_hal, gpio_num);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_input_disable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_sleep_input_disable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_input_enable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_sleep_input_enable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_output_disable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_sleep_output_disable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-static esp_err_t gpio_sleep_output_enable(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO output gpio_num error", ESP_ERR_INVALID_ARG);
-    gpio_hal_sleep_output_enable(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_sleep_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (mode & GPIO_MODE_DEF_OUTPUT)) {
-        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    esp_err_t ret = ESP_OK;
-
-    if (mode & GPIO_MODE_DEF_INPUT) {
-        gpio_sleep_input_enable(gpio_num);
-    } else {
-        gpio_sleep_input_disable(gpio_num);
-    }
-
-    if (mode & GPIO_MODE_DEF_OUTPUT) {
-        gpio_sleep_output_enable(gpio_num);
-    } else {
-        gpio_sleep_output_disable(gpio_num);
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_sleep_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    GPIO_CHECK(pull <= GPIO_FLOATING, "GPIO pull mode error", ESP_ERR_INVALID_ARG);
-    esp_err_t ret = ESP_OK;
-
-    switch (pull) {
-        case GPIO_PULLUP_ONLY:
-            gpio_sleep_pulldown_dis(gpio_num);
-            gpio_sleep_pullup_en(gpio_num);
-            break;
-
-        case GPIO_PULLDOWN_ONLY:
-            gpio_sleep_pulldown_en(gpio_num);
-            gpio_sleep_pullup_dis(gpio_num);
-            break;
-
-        case GPIO_PULLUP_PULLDOWN:
-            gpio_sleep_pulldown_en(gpio_num);
-            gpio_sleep_pullup_en(gpio_num);
-            break;
-
-        case GPIO_FLOATING:
-            gpio_sleep_pulldown_dis(gpio_num);
-            gpio_sleep_pullup_dis(gpio_num);
-            break;
-
-        default:
-            ESP_LOGE(GPIO_TAG, "Unknown pull up/down mode,gpio_num=%u,pull=%u", gpio_num, pull);
-            ret = ESP_ERR_INVALID_ARG;
-            break;
-    }
-
-    return ret;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_sleep_sel_en(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_sleep_sel_en(gpio_context.gpio_hal, gpio_num);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-
-    return ESP_OK;
-}
-/**************************************************************************
-* Function: Nombre de la funci?n
-* Preconditions: Qu? funciones o declaraciones son previas al programa
-* Overview: resumen del programa.
-* Input: argumentos de entrada.
-* Output: argumentos de salida
-*
-*****************************************************************************/
-
-esp_err_t gpio_sleep_sel_dis(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_sleep_sel_dis(gpio_context.gpio_hal, gpio_num);
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-
-    return ESP_OK;
-}
-
-#if CONFIG_GPIO_ESP32_SUPPORT_SWITCH_SLP_PULL
-esp_err_t gpio_sleep_pupd_config_apply(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_sleep_pupd_config_apply(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-
-esp_err_t gpio_sleep_pupd_config_unapply(gpio_num_t gpio_num)
-{
-    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
-    gpio_hal_sleep_pupd_config_unapply(gpio_context.gpio_hal, gpio_num);
-    return ESP_OK;
-}
-#endif // CONFIG_GPIO_ESP32_SUPPORT_SWITCH_SLP_PULL
-
-#if SOC_GPIO_SUPPORT_DEEPSLEEP_WAKEUP
-esp_err_t gpio_deep_sleep_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
-{
-    if (!gpio_hal_is_valid_deepsleep_wakeup_gpio(gpio_num)) {
-        ESP_LOGE(GPIO_TAG, "GPIO %d does not support deep sleep wakeup", gpio_num);
-        return ESP_ERR_INVALID_ARG;
-    }
-    if ((intr_type != GPIO_INTR_LOW_LEVEL) && (intr_type != GPIO_INTR_HIGH_LEVEL)) {
-        ESP_LOGE(GPIO_TAG, "GPIO wakeup only supports level mode, but edge mode set. gpio_num:%u", gpio_num);
-        return ESP_ERR_INVALID_ARG;
-    }
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_deepsleep_wakeup_enable(gpio_context.gpio_hal, gpio_num, intr_type);
-#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
-    gpio_hal_sleep_sel_dis(gpio_context.gpio_hal, gpio_num);
-#endif
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return ESP_OK;
-}
-
-esp_err_t gpio_deep_sleep_wakeup_disable(gpio_num_t gpio_num)
-{
-    if (!gpio_hal_is_valid_deepsleep_wakeup_gpio(gpio_num)) {
-        ESP_LOGE(GPIO_TAG, "GPIO %d does not support deep sleep wakeup", gpio_num);
-        return ESP_ERR_INVALID_ARG;
-    }
-    portENTER_CRITICAL(&gpio_context.gpio_spinlock);
-    gpio_hal_deepsleep_wakeup_disable(gpio_context.gpio_hal, gpio_num);
-#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
-    gpio_hal_sleep_sel_en(gpio_context.gpio_hal, gpio_num);
-#endif
-    portEXIT_CRITICAL(&gpio_context.gpio_spinlock);
-    return ESP_OK;
-}
-#endif // SOC_GPIO_SUPPORT_DEEPSLEEP_WAKEUP
-
-
-
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <esp_types.h>
+#include <string.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "GPIO_1/INCLUDE/GPIO_1.h"
+#include "driver/rtc_io.h"
+#include "soc/soc.h"
+#include "soc/periph_defs.h"
+#if !CONFIG_FREERTOS_UNICORE
+#include "esp_ipc.h"
+#endif
+
+#include "soc/soc_caps.h"
+#include "soc/gpio_periph.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "DRIVERS/GPIO_HAL_FINAL.h"
+#include "esp_rom_gpio.h"
+
+static const char *GPIO_TAG = "gpio";
+#define GPIO_CHECK(a, str, ret_val) ESP_RETURN_ON_FALSE(a, ret_val, GPIO_TAG, "%s", str)
+
+#define GPIO_ISR_CORE_ID_UNINIT    (3)
+
+//default value for SOC_GPIO_SUPPORT_RTC_INDEPENDENT is 0
+#ifndef SOC_GPIO_SUPPORT_RTC_INDEPENDENT
+#define SOC_GPIO_SUPPORT_RTC_INDEPENDENT 0
+#endif
+
+//Copia en DRAM de los registros IOMUX de cada pin, deshabilitada por defecto
+#ifndef CONFIG_GPIO_IOMUX_SHADOW
+#define CONFIG_GPIO_IOMUX_SHADOW 0
+#endif
+
+//Conteo de secciones criticas del driver, deshabilitado por defecto
+#ifndef CONFIG_GPIO_CRITICAL_STATS
+#define CONFIG_GPIO_CRITICAL_STATS 0
+#endif
+
+//Estadisticas de interrupcion por pin, deshabilitadas por defecto
+#ifndef CONFIG_GPIO_ISR_STATS
+#define CONFIG_GPIO_ISR_STATS 0
+#endif
+
+//Tabla de handlers del servicio de ISR en DRAM estatica en lugar del heap, deshabilitada por defecto
+#ifndef CONFIG_GPIO_ISR_STATIC_TABLE
+#define CONFIG_GPIO_ISR_STATIC_TABLE 0
+#endif
+
+//Numero de nodos para handlers encadenados (gpio_isr_handler_chain_add), compartidos por todos los pines
+#ifndef CONFIG_GPIO_ISR_CHAIN_POOL_SIZE
+#define CONFIG_GPIO_ISR_CHAIN_POOL_SIZE 8
+#endif
+
+//Prioridad y stack de la tarea que ejecuta los handlers diferidos (gpio_isr_handler_add_deferred)
+#ifndef CONFIG_GPIO_DEFERRED_TASK_PRIORITY
+#define CONFIG_GPIO_DEFERRED_TASK_PRIORITY (configMAX_PRIORITIES - 2)
+#endif
+#ifndef CONFIG_GPIO_DEFERRED_TASK_STACK
+#define CONFIG_GPIO_DEFERRED_TASK_STACK 3072
+#endif
+
+//Numero de grupos de coalescencia (gpio_coalesce_group_add)
+#ifndef CONFIG_GPIO_COALESCE_GROUPS
+#define CONFIG_GPIO_COALESCE_GROUPS 2
+#endif
+
+//Numero de eventos de la cola ISR -> tarea, debe ser potencia de 2
+#ifndef CONFIG_GPIO_EVENT_QUEUE_LEN
+#define CONFIG_GPIO_EVENT_QUEUE_LEN 32
+#endif
+_Static_assert((CONFIG_GPIO_EVENT_QUEUE_LEN & (CONFIG_GPIO_EVENT_QUEUE_LEN - 1)) == 0,
+               "CONFIG_GPIO_EVENT_QUEUE_LEN must be a power of 2");
+
+typedef struct {
+    gpio_isr_t fn;   /*!< isr function */
+    void *args;      /*!< isr function args */
+} gpio_isr_func_t;
+
+// Used by the IPC call to register the interrupt service routine.
+typedef struct {
+    int source;               /*!< ISR source */
+    int intr_alloc_flags;     /*!< ISR alloc flag */
+    void (*fn)(void*);        /*!< ISR function */
+    void *arg;                /*!< ISR function args*/
+    void *handle;             /*!< ISR handle */
+    esp_err_t ret;
+} gpio_isr_alloc_t;
+
+typedef struct {
+    gpio_hal_context_t *gpio_hal;
+    portMUX_TYPE gpio_spinlock;
+    uint32_t isr_core_id;
+    gpio_isr_func_t *gpio_isr_func;        // tabla de handlers; distinto de NULL mientras el servicio de ISR esta instalado
+    gpio_isr_handle_t gpio_isr_handle[portNUM_PROCESSORS]; // servicio de ISR de cada nucleo, NULL si no esta instalado
+    uint64_t isr_clr_on_entry_mask; // for edge-triggered interrupts, interrupt status bits should be cleared before entering per-pin handlers
+    uint64_t throttle_mask;                // pines con limite de eventos por ventana
+    uint64_t throttled_mask;               // pines deshabilitados por el limite, pendientes de rearmar
+    uint64_t deferred_mask;                // pines cuyo handler se ejecuta en la tarea de handlers diferidos
+    uint64_t intr_prio_mask[GPIO_INTR_PRIO_MAX]; // pines de cada clase de prioridad; NORMAL no se usa, es el resto
+    uint64_t deferred_masked_mask;         // pines por nivel deshabilitados por el ISR hasta que corra su handler diferido
+    uint64_t coalesce_mask;                // pines que pertenecen a algun grupo de coalescencia
+    uint64_t debounce_mask;                // pines con antirrebote por timer
+    uint64_t intr_affinity_mask;           // pines con nucleo fijo (gpio_isr_handler_add_on_core)
+    uint64_t intr_app_cpu_mask;            // de los pines con nucleo fijo, los atendidos por el nucleo 1
+    gpio_isr_timestamp_t isr_entry[portNUM_PROCESSORS]; // marca de tiempo tomada al entrar a gpio_intr_service
+    uint32_t isr_seq[portNUM_PROCESSORS];  // impar mientras el ISR de ese nucleo recorre los handlers
+#if CONFIG_GPIO_CRITICAL_STATS
+    uint32_t critical_count;               // secciones criticas tomadas desde el ultimo reinicio del contador
+#endif
+#if CONFIG_GPIO_IOMUX_SHADOW
+    uint32_t iomux_shadow[GPIO_PIN_COUNT]; // ultima palabra IOMUX escrita/leida de cada pin
+    uint64_t iomux_shadow_valid;           // pines cuya copia en iomux_shadow es valida
+#endif
+} gpio_context_t;
+
+
+typedef struct {
+    uint64_t pin_bit_mask;          /*!<Pin GPIO: configurado con m?scara de bits, cada bit se asigna a un GPIO */
+    gpio_mode_t mode;               /*!< Modo GPIO: establece el modo de entrada/salida                     */
+    gpio_pullup_t pull_up_en;       /*!< GPIO pull-up                                         */
+    gpio_pulldown_t pull_down_en;   /*!< GPIO pull-down                                       */
+    gpio_int_type_t intr_type;      /*!< Tipo de interrupci?n GPIO                                 */
+} gpio_config_t;
+
+
+static gpio_hal_context_t _gpio_hal = {
+    .dev = GPIO_HAL_GET_HW(GPIO_PORT_0)
+};
+
+static gpio_context_t gpio_context = {
+    .gpio_hal = &_gpio_hal,
+    .gpio_spinlock = portMUX_INITIALIZER_UNLOCKED,
+    .isr_core_id = GPIO_ISR_CORE_ID_UNINIT,
+    .gpio_isr_func = NULL,
+    .isr_clr_on_entry_mask = 0,
+};
+
+/*
+ * Cola de eventos ISR -> tarea. Un solo productor (gpio_intr_service) y un solo lector
+ * (gpio_event_read): head solo lo escribe el ISR, sin spinlock, y tail la tarea lectora o
+ * gpio_event_queue_uninstall, con el spinlock. Los indices avanzan libremente y se enmascaran
+ * al acceder a events[]. El ISR solo notifica mientras waiting tiene al lector bloqueado y lo
+ * limpia con el spinlock al notificar, igual que en gpio_wait_any.
+ * Las mascaras van separadas en dos palabras de 32 bits, igual que los registros de estado,
+ * para que el ISR nunca lea una mascara escrita a medias. Para que haya un solo productor con
+ * el servicio instalado en los dos nucleos, todos los pines de la mascara deben atenderse en
+ * el mismo nucleo (core).
+ */
+typedef struct {
+    gpio_event_t events[CONFIG_GPIO_EVENT_QUEUE_LEN];
+    uint32_t head;            // siguiente posicion a escribir (ISR)
+    uint32_t tail;            // siguiente posicion a leer (tarea lectora)
+    uint32_t mask;            // pines GPIO0-31 que generan eventos
+    uint32_t mask_h;          // pines GPIO32-39 que generan eventos
+    uint32_t core;            // nucleo que atiende todos los pines de la mascara
+    TaskHandle_t waiting;     // tarea bloqueada en gpio_event_read, NULL si nadie espera
+    uint32_t dropped;         // eventos descartados por cola llena
+    uint32_t high_water;      // maximo de eventos pendientes
+} gpio_event_queue_t;
+
+static DRAM_ATTR gpio_event_queue_t gpio_event_queue;
+
+/*
+ * Con CONFIG_GPIO_ISR_STATIC_TABLE la tabla de handlers es un arreglo estatico en DRAM interna:
+ * install no reserva memoria y el ISR indexa el arreglo directamente, sin leer el apuntador
+ * gpio_context.gpio_isr_func (que solo indica si el servicio esta instalado).
+ */
+#if CONFIG_GPIO_ISR_STATIC_TABLE
+static DRAM_ATTR gpio_isr_func_t gpio_isr_func_table[GPIO_NUM_MAX];
+#define GPIO_ISR_FUNC(gpio_num)    (gpio_isr_func_table[gpio_num])
+#else
+#define GPIO_ISR_FUNC(gpio_num)    (gpio_context.gpio_isr_func[gpio_num])
+#endif
+
+/*
+ * Handlers encadenados. Los nodos salen de un arreglo estatico, asi que no se usa el heap.
+ * Cada lista esta ordenada por prioridad (mayor primero) y solo se modifica con el spinlock;
+ * el ISR la recorre sin spinlock, por eso un nodo se enlaza ya inicializado y, al quitarlo,
+ * se desenlaza primero y se devuelve al arreglo hasta que ningun ISR pueda estar usandolo
+ * (gpio_isr_chain_sync).
+ */
+typedef struct gpio_isr_chain_node {
+    gpio_isr_t fn;
+    void *args;
+    uint8_t priority;
+    bool in_use;
+    struct gpio_isr_chain_node *next;
+} gpio_isr_chain_node_t;
+
+static DRAM_ATTR gpio_isr_chain_node_t gpio_isr_chain_pool[CONFIG_GPIO_ISR_CHAIN_POOL_SIZE];
+static DRAM_ATTR gpio_isr_chain_node_t *gpio_isr_chain[GPIO_NUM_MAX];
+
+/*
+ * Handlers diferidos. El ISR solo marca el pin en pending/pending_h, guarda la marca de tiempo y
+ * notifica a la tarea, que ejecuta los handlers fuera de la interrupcion. Los pines por nivel
+ * se deshabilitan en el ISR (si no, la interrupcion se repetiria hasta que corra el handler) y
+ * la tarea los vuelve a habilitar despues del handler.
+ */
+typedef struct {
+    gpio_deferred_handler_t fn;
+    void *args;
+} gpio_deferred_func_t;
+
+typedef struct {
+    gpio_deferred_func_t func[GPIO_NUM_MAX];
+    gpio_isr_timestamp_t time[GPIO_NUM_MAX]; // marca del ultimo evento de cada pin
+    uint32_t pending;                        // pines GPIO0-31 con handler pendiente
+    uint32_t pending_h;                      // pines GPIO32-39 con handler pendiente
+    TaskHandle_t task;
+} gpio_deferred_t;
+
+static DRAM_ATTR gpio_deferred_t gpio_deferred;
+
+/*
+ * Espera de flanco por pin (gpio_wait_edge). task es la tarea que espera el pin, NULL si nadie
+ * espera; el handler guarda la marca de tiempo y pone fired. Como en gpio_wait_any, solo
+ * notifica mientras waiting tiene la tarea bloqueada y lo limpia con el spinlock al notificar.
+ */
+typedef struct {
+    TaskHandle_t task;        // tarea que espera el pin
+    TaskHandle_t waiting;     // la misma tarea mientras esta bloqueada, NULL si no
+    bool fired;
+    gpio_isr_timestamp_t time;
+} gpio_wait_t;
+
+static DRAM_ATTR gpio_wait_t gpio_wait[GPIO_NUM_MAX];
+
+/*
+ * Espera de varios pines (gpio_wait_any). Una vez registrada la mascara, el ISR acumula en
+ * fired/fired_h todos los pines que disparan, aunque la tarea no este esperando; cada
+ * llamada a gpio_wait_any toma y limpia lo acumulado, asi que no se pierde ningun flanco entre
+ * esperas. Las mascaras van en dos palabras de 32 bits como en la cola de eventos.
+ * El ISR solo notifica mientras waiting tiene la tarea bloqueada y lo limpia con el spinlock
+ * al notificar; asi no quedan notificaciones para otros ulTaskNotifyTake de la tarea.
+ */
+typedef struct {
+    uint32_t mask;            // pines GPIO0-31 vigilados
+    uint32_t mask_h;          // pines GPIO32-39 vigilados
+    uint32_t fired;           // pines GPIO0-31 que dispararon desde la ultima lectura
+    uint32_t fired_h;         // pines GPIO32-39 que dispararon desde la ultima lectura
+    TaskHandle_t task;        // tarea registrada con la mascara
+    TaskHandle_t waiting;     // tarea bloqueada en gpio_wait_any, NULL si nadie espera
+} gpio_wait_any_t;
+
+static DRAM_ATTR gpio_wait_any_t gpio_wait_any_state;
+
+/*
+ * Grupos de coalescencia. El ISR acumula los eventos de los pines del grupo en batch (con el
+ * spinlock, porque el callback del timer lo copia desde otro contexto). El primer evento arranca
+ * el timer de la ventana; si se llega a max_events el timer se dispara de inmediato. El
+ * callback del timer toma el lote, lo deja vacio y lo entrega al callback del usuario.
+ */
+typedef struct {
+    uint64_t mask;                  // pines del grupo, 0 si el grupo esta libre
+    uint32_t window_us;             // duracion de la ventana
+    uint32_t max_events;            // eventos que adelantan la entrega, 0 sin limite
+    gpio_coalesce_cb_t callback;
+    void *arg;
+    esp_timer_handle_t timer;
+    bool flushing;                  // el callback del usuario esta corriendo en la tarea de esp_timer
+    gpio_coalesce_batch_t batch;    // lote en construccion
+} gpio_coalesce_group_t;
+
+static DRAM_ATTR gpio_coalesce_group_t gpio_coalesce[CONFIG_GPIO_COALESCE_GROUPS];
+
+/*
+ * Antirrebote por timer. Cada flanco de un pin lo arma y mueve su vencimiento a
+ * ahora + stable_us. Un solo esp_timer compartido se programa al vencimiento mas cercano
+ * (timer_deadline, 0 si esta detenido); su callback lee el nivel de los pines vencidos y, si
+ * cambio respecto a state, entrega el evento de presion o liberacion.
+ */
+typedef struct {
+    uint64_t armed;                         // pines esperando a que su nivel se estabilice
+    uint64_t state;                         // ultimo nivel estable de cada pin
+    uint64_t active_low;                    // pines que se presionan en nivel bajo
+    int64_t timer_deadline;                 // vencimiento programado del timer, 0 si esta detenido
+    esp_timer_handle_t timer;               // timer compartido por todos los pines
+    uint32_t stable_us[GPIO_NUM_MAX];       // tiempo que el nivel debe mantenerse
+    int64_t deadline[GPIO_NUM_MAX];         // vencimiento de cada pin armado
+    gpio_debounce_cb_t callback[GPIO_NUM_MAX];
+    void *arg[GPIO_NUM_MAX];
+} gpio_debounce_t;
+
+static DRAM_ATTR gpio_debounce_t gpio_debounce;
+
+/*
+ * Antirrebote por muestreo de todo el puerto. Cada tick lee in/in1 como una palabra de 64 bits
+ * y avanza un contador vertical de 2 bits por pin (bit bajo en ct0, bit alto en ct1): un pin
+ * cambia de estado despues de 4 muestras seguidas distintas a su estado. El costo del tick no
+ * depende del numero de pines. Solo lo usa la tarea de esp_timer y las lecturas del usuario.
+ */
+typedef struct {
+    uint64_t mask;                  // pines muestreados
+    uint64_t ct0;                   // bit bajo del contador de cada pin
+    uint64_t ct1;                   // bit alto del contador de cada pin
+    uint64_t state;                 // estado sin rebote
+    uint64_t changed;               // pines que cambiaron desde la ultima lectura
+    gpio_scan_cb_t callback;
+    void *arg;
+    esp_timer_handle_t timer;       // timer periodico del muestreo
+} gpio_scan_t;
+
+static gpio_scan_t gpio_scan;
+
+/*
+ * Limite de eventos por pin. El ISR cuenta los eventos de la ventana actual; si se pasa de
+ * max_events deshabilita la interrupcion del pin y arranca el timer del pin, que la rearma
+ * despues de backoff_us << backoff_shift. Cada tormenta seguida duplica la espera hasta
+ * GPIO_THROTTLE_MAX_SHIFT; una ventana completa sin pasarse la regresa a backoff_us.
+ */
+#define GPIO_THROTTLE_MAX_SHIFT    (5)
+
+typedef struct {
+    uint32_t max_events;      // eventos permitidos por ventana, 0 sin limite
+    uint32_t window_us;       // duracion de la ventana
+    uint32_t backoff_us;      // espera base antes de rearmar
+    uint32_t window_start;    // inicio de la ventana actual (esp_timer, 32 bits bajos)
+    uint32_t count;           // eventos en la ventana actual
+    uint32_t backoff_shift;   // tormentas seguidas
+    uint32_t last_backoff;    // ultima espera aplicada, para el reporte
+    uint32_t storms;          // veces que se deshabilito el pin
+    esp_timer_handle_t timer; // timer de rearme del pin
+} gpio_throttle_t;
+
+static DRAM_ATTR gpio_throttle_t gpio_throttle[GPIO_NUM_MAX];
+
+#if CONFIG_GPIO_ISR_STATS
+/*
+ * Estadisticas por pin. Cada pin se atiende en un solo nucleo, asi que hay un solo escritor
+ * (el ISR). seq es impar mientras el ISR actualiza la entrada; gpio_isr_stats_get copia la
+ * entrada y la repite si seq cambio, sin deshabilitar interrupciones. reset lo pone la tarea
+ * y lo consume el ISR en la siguiente actualizacion.
+ */
+typedef struct {
+    uint32_t seq;
+    uint8_t reset;
+    gpio_isr_pin_stats_t stats;
+} gpio_isr_stats_entry_t;
+
+static DRAM_ATTR gpio_isr_stats_entry_t gpio_isr_stats[GPIO_NUM_MAX];
+#endif
+
+/*
+ * Uso del spinlock del driver:
+ * - Sin spinlock: escrituras a registros w1ts/w1tc (nivel de salida, habilitacion de salida,
+ *   limpieza del estado de interrupcion) y escrituras completas de registro (func_out_sel_cfg).
+ *   El hardware las aplica de forma atomica.
+ * - Con spinlock: lectura-modificacion-escritura de registros compartidos entre campos
+ *   (IOMUX de cada pin; pin[n], que contiene int_type, int_ena, pad_driver y wakeup;
+ *   registros de hold) y del estado del driver (isr_clr_on_entry_mask, copia IOMUX).
+ */
+#if CONFIG_GPIO_CRITICAL_STATS
+#define GPIO_ENTER_CRITICAL()   do { portENTER_CRITICAL(&gpio_context.gpio_spinlock); gpio_context.critical_count++; } while (0)
+#else
+#define GPIO_ENTER_CRITICAL()   portENTER_CRITICAL(&gpio_context.gpio_spinlock)
+#endif
+#define GPIO_EXIT_CRITICAL()    portEXIT_CRITICAL(&gpio_context.gpio_spinlock)
+#define GPIO_ENTER_CRITICAL_ISR()   portENTER_CRITICAL_ISR(&gpio_context.gpio_spinlock)
+#define GPIO_EXIT_CRITICAL_ISR()    portEXIT_CRITICAL_ISR(&gpio_context.gpio_spinlock)
+/**************************************************************************
+* Function: gpio_iomux_load
+* Preconditions: gpio_spinlock tomado
+* Overview: Devuelve la palabra IOMUX de un pin. Con CONFIG_GPIO_IOMUX_SHADOW se sirve de la
+* 			copia en DRAM; si el pin no esta en la copia se lee una vez del hardware.
+* Input: io_num: Numero de GPIO.
+* Output: Palabra de configuracion IOMUX
+*
+*****************************************************************************/
+static inline uint32_t gpio_iomux_load(uint32_t io_num)
+{
+#if CONFIG_GPIO_IOMUX_SHADOW
+    if (!(gpio_context.iomux_shadow_valid & BIT64(io_num))) {
+        gpio_context.iomux_shadow[io_num] = gpio_hal_iomux_read(GPIO_PIN_MUX_REG[io_num]);
+        gpio_context.iomux_shadow_valid |= BIT64(io_num);
+    }
+    return gpio_context.iomux_shadow[io_num];
+#else
+    return gpio_hal_iomux_read(GPIO_PIN_MUX_REG[io_num]);
+#endif
+}
+/**************************************************************************
+* Function: gpio_iomux_get
+* Overview: Igual que gpio_iomux_load pero puede llamarse sin el spinlock. Si el pin ya
+* 			esta en la copia no se toma el spinlock ni se accede al hardware.
+* Input: io_num: Numero de GPIO.
+* Output: Palabra de configuracion IOMUX
+*
+*****************************************************************************/
+static inline uint32_t gpio_iomux_get(uint32_t io_num)
+{
+#if CONFIG_GPIO_IOMUX_SHADOW
+    if (gpio_context.iomux_shadow_valid & BIT64(io_num)) {
+        return gpio_context.iomux_shadow[io_num];
+    }
+#endif
+    GPIO_ENTER_CRITICAL();
+    uint32_t val = gpio_iomux_load(io_num);
+    GPIO_EXIT_CRITICAL();
+    return val;
+}
+/**************************************************************************
+* Function: gpio_iomux_modify
+* Preconditions: gpio_spinlock tomado
+* Overview: Modifica campos de la palabra IOMUX de un pin. El cambio se aplica primero a la
+* 			copia en DRAM y despues se escribe al hardware, sin leer el registro.
+* Input: io_num: Numero de GPIO.
+* 		 clr_bits: Bits a limpiar.
+* 		 set_bits: Bits a activar.
+*
+*****************************************************************************/
+static inline void gpio_iomux_modify(uint32_t io_num, uint32_t clr_bits, uint32_t set_bits)
+{
+#if CONFIG_GPIO_IOMUX_SHADOW
+    uint32_t val = (gpio_iomux_load(io_num) & ~clr_bits) | set_bits;
+    gpio_context.iomux_shadow[io_num] = val;
+    gpio_hal_iomux_write(GPIO_PIN_MUX_REG[io_num], val);
+#else
+    gpio_hal_iomux_update(GPIO_PIN_MUX_REG[io_num], clr_bits, set_bits);
+#endif
+}
+/**************************************************************************
+* Function: gpio_iomux_invalidate
+* Preconditions: gpio_spinlock tomado, en la misma seccion critica que la escritura
+* Overview: Descarta la copia IOMUX de los pines de la mascara. Se usa con las escrituras
+* 			que no pasan por gpio_iomux_modify; la siguiente lectura recarga del hardware.
+* 			Debe ir antes de soltar el spinlock: si no, un gpio_iomux_modify de otro nucleo
+* 			podria escribir la copia vieja encima de la escritura.
+* Input: mask: Mascara de 64 bits con los pines.
+*
+*****************************************************************************/
+static inline void gpio_iomux_invalidate(uint64_t mask)
+{
+#if CONFIG_GPIO_IOMUX_SHADOW
+    gpio_context.iomux_shadow_valid &= ~mask;
+#else
+    (void)mask;
+#endif
+}
+/**************************************************************************
+* Function: gpio_set_output
+* Overview: Funcion que configura el pin seleccionado como salida.
+* Input: gpio_num.
+* Output: ret
+*
+*****************************************************************************/
+esp_err_t gpio_set_output(gpio_num_t gpio_num){
+	   GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+	    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (GPIO_MODE_DEF_OUTPUT)) {
+	        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
+	        return ESP_ERR_INVALID_ARG;
+	    }
+	    esp_err_t ret = ESP_OK;
+	    gpio_output_enable(gpio_num);
+	    return ret;
+}
+/**************************************************************************
+* Function: gpio_set_input_pullup
+* Overview: Funcion que configura el pin como entrada y activa el pullup.
+* Input: gpio_num.
+* Output: ret
+*
+*****************************************************************************/
+esp_err_t gpio_set_input_pullup(gpio_num_t gpio_num){
+	 GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+	    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (GPIO_MODE_DEF_INPUT & GPIO_MODE_DEF_OUTPUT)) {
+	        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
+	        return ESP_ERR_INVALID_ARG;
+	    }
+	    esp_err_t ret = ESP_OK;
+	    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+	        // Entrada y pullup en una sola escritura de la palabra IOMUX
+	        GPIO_ENTER_CRITICAL();
+	        gpio_iomux_modify(gpio_num, 0, FUN_IE | FUN_PU);
+	        GPIO_EXIT_CRITICAL();
+	    } else {
+	        GPIO_ENTER_CRITICAL();
+	        gpio_iomux_modify(gpio_num, 0, FUN_IE);
+	        GPIO_EXIT_CRITICAL();
+	#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+	        rtc_gpio_pullup_en(gpio_num);
+	#else
+	        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+	#endif
+	    }
+
+	    return ret;
+}
+/**************************************************************************
+* Function: gpio_set_input_pulldown
+* Overview: Funcion que habilita el pin seleccionado como entrada y activa el pulldown.
+* Input: gpio_num.
+* Output: ret
+*
+*****************************************************************************/
+esp_err_t gpio_set_input_pulldown(gpio_num_t gpio_num){
+	 GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+	    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (GPIO_MODE_DEF_INPUT & GPIO_MODE_DEF_OUTPUT)) {
+	        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
+	        return ESP_ERR_INVALID_ARG;
+	    }
+	    esp_err_t ret = ESP_OK;
+	    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+	        // Entrada y pulldown en una sola escritura de la palabra IOMUX
+	        GPIO_ENTER_CRITICAL();
+	        gpio_iomux_modify(gpio_num, 0, FUN_IE | FUN_PD);
+	        GPIO_EXIT_CRITICAL();
+	    } else {
+	        GPIO_ENTER_CRITICAL();
+	        gpio_iomux_modify(gpio_num, 0, FUN_IE);
+	        GPIO_EXIT_CRITICAL();
+	#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+	        rtc_gpio_pulldown_en(gpio_num);
+	#else
+	        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+	#endif
+	    }
+
+	    return ret;
+}
+/**************************************************************************
+* Function: gpio_set_input_isr
+* Overview: Funcion que configura el pin como entrada y permite configurar las interrupciones.
+* Input: gpio_num
+* 		 isr_type
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_set_input_isr(gpio_num_t gpio_num, gpio_int_type_t isr_type){
+	gpio_config_t pGPIOConfig;
+	pGPIOConfig.pin_bit_mask = (1ULL << gpio_num);
+	pGPIOConfig.mode = GPIO_MODE_DEF_INPUT;
+	pGPIOConfig.pull_up_en = GPIO_PULLUP_DISABLE;
+	pGPIOConfig.pull_down_en = GPIO_PULLDOWN_DISABLE;
+	pGPIOConfig.intr_type = isr_type;
+
+	gpio_config(&pGPIOConfig);
+
+	return ESP_OK;
+}
+
+/**************************************************************************
+* Function: gpio_bank_init
+* Overview: Funcion que valida una mascara de pines y precalcula los datos del banco:
+* 			la mascara de pines con capacidad de salida y la de pines RTC, cuyas
+* 			resistencias de pull se manejan desde RTC_IO y no desde IO_MUX.
+* Input: bank: Descriptor del banco a inicializar.
+* 		 mask: Mascara de 64 bits con los pines del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_init(gpio_bank_t *bank, uint64_t mask)
+{
+    GPIO_CHECK(bank != NULL, "GPIO bank error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(mask != 0 && (mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO bank mask error", ESP_ERR_INVALID_ARG);
+
+    uint64_t rtc_mask = 0;
+    uint64_t pins = mask;
+    while (pins && !SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        gpio_num_t gpio_num = (gpio_num_t)__builtin_ctzll(pins);
+        pins &= pins - 1;
+        if (rtc_gpio_is_valid_gpio(gpio_num)) {
+            rtc_mask |= BIT64(gpio_num);
+        }
+    }
+
+    bank->output_mask = mask & SOC_GPIO_VALID_OUTPUT_GPIO_MASK;
+    bank->rtc_mask = rtc_mask;
+    bank->mask = mask;
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_get_left_bank / gpio_get_right_bank
+* Overview: Funciones que devuelven los bancos predefinidos de cada lado de la tarjeta.
+* 			Sus mascaras son constantes, asi que los bancos se inicializan en compilacion,
+* 			con el mismo resultado que gpio_bank_init.
+* Output: Puntero al banco
+*
+*****************************************************************************/
+#define GPIO_BANK_RTC_MASK(mask) (SOC_GPIO_SUPPORT_RTC_INDEPENDENT ? 0 : ((mask) & GPIO_HAL_RTC_IO_MASK))
+
+static const gpio_bank_t gpio_left_bank = {
+    .mask = GPIO_HAL_LEFT_BANK_MASK,
+    .output_mask = GPIO_HAL_LEFT_BANK_OUTPUT_MASK,
+    .rtc_mask = GPIO_BANK_RTC_MASK(GPIO_HAL_LEFT_BANK_MASK),
+};
+static const gpio_bank_t gpio_right_bank = {
+    .mask = GPIO_HAL_RIGHT_BANK_MASK,
+    .output_mask = GPIO_HAL_RIGHT_BANK_OUTPUT_MASK,
+    .rtc_mask = GPIO_BANK_RTC_MASK(GPIO_HAL_RIGHT_BANK_MASK),
+};
+
+static const gpio_bank_t *gpio_get_left_bank(void)
+{
+    return &gpio_left_bank;
+}
+
+static const gpio_bank_t *gpio_get_right_bank(void)
+{
+    return &gpio_right_bank;
+}
+/**************************************************************************
+* Function: gpio_bank_output_enable
+* Preconditions: gpio_bank_init
+* Overview: Funcion que activa como salida los pines del banco con capacidad de salida,
+* 			una escritura por registro de habilitacion.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_output_enable(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+    gpio_hal_output_enable_mask(gpio_context.gpio_hal, bank->output_mask);
+    gpio_hal_connect_gpio_out_mask(gpio_context.gpio_hal, bank->output_mask);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_output_disable
+* Preconditions: gpio_bank_init
+* Overview: Funcion que desactiva como salida los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_output_disable(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+    gpio_hal_output_disable_mask(gpio_context.gpio_hal, bank->output_mask);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_input_enable
+* Preconditions: gpio_bank_init
+* Overview: Funcion que activa como entrada los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_input_enable(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_input_enable_mask(gpio_context.gpio_hal, bank->mask);
+    gpio_iomux_invalidate(bank->mask);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_input_disable
+* Preconditions: gpio_bank_init
+* Overview: Funcion que desactiva como entrada los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_input_disable(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_input_disable_mask(gpio_context.gpio_hal, bank->mask);
+    gpio_iomux_invalidate(bank->mask);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_pullup_en
+* Preconditions: gpio_bank_init
+* Overview: Funcion que activa las resistencias de pullup de los pines del banco. Los pines
+* 			digitales se escriben en IO_MUX bajo una sola seccion critica y los pines RTC
+* 			a traves de RTC_IO.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pullup_en(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_pullup_en_mask(gpio_context.gpio_hal, bank->mask & ~bank->rtc_mask);
+    gpio_iomux_invalidate(bank->mask & ~bank->rtc_mask);
+    GPIO_EXIT_CRITICAL();
+
+    uint64_t rtc_mask = bank->rtc_mask;
+    while (rtc_mask) {
+        gpio_num_t gpio_num = (gpio_num_t)__builtin_ctzll(rtc_mask);
+        rtc_mask &= rtc_mask - 1;
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pullup_en(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_pullup_dis
+* Preconditions: gpio_bank_init
+* Overview: Funcion que desactiva las resistencias de pullup de los pines del banco. Los pines
+* 			digitales se escriben en IO_MUX bajo una sola seccion critica y los pines RTC
+* 			a traves de RTC_IO.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pullup_dis(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_pullup_dis_mask(gpio_context.gpio_hal, bank->mask & ~bank->rtc_mask);
+    gpio_iomux_invalidate(bank->mask & ~bank->rtc_mask);
+    GPIO_EXIT_CRITICAL();
+
+    uint64_t rtc_mask = bank->rtc_mask;
+    while (rtc_mask) {
+        gpio_num_t gpio_num = (gpio_num_t)__builtin_ctzll(rtc_mask);
+        rtc_mask &= rtc_mask - 1;
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pullup_dis(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_pulldown_en
+* Preconditions: gpio_bank_init
+* Overview: Funcion que activa las resistencias de pulldown de los pines del banco. Los pines
+* 			digitales se escriben en IO_MUX bajo una sola seccion critica y los pines RTC
+* 			a traves de RTC_IO.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pulldown_en(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_pulldown_en_mask(gpio_context.gpio_hal, bank->mask & ~bank->rtc_mask);
+    gpio_iomux_invalidate(bank->mask & ~bank->rtc_mask);
+    GPIO_EXIT_CRITICAL();
+
+    uint64_t rtc_mask = bank->rtc_mask;
+    while (rtc_mask) {
+        gpio_num_t gpio_num = (gpio_num_t)__builtin_ctzll(rtc_mask);
+        rtc_mask &= rtc_mask - 1;
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pulldown_en(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_pulldown_dis
+* Preconditions: gpio_bank_init
+* Overview: Funcion que desactiva las resistencias de pulldown de los pines del banco. Los pines
+* 			digitales se escriben en IO_MUX bajo una sola seccion critica y los pines RTC
+* 			a traves de RTC_IO.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pulldown_dis(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_pulldown_dis_mask(gpio_context.gpio_hal, bank->mask & ~bank->rtc_mask);
+    gpio_iomux_invalidate(bank->mask & ~bank->rtc_mask);
+    GPIO_EXIT_CRITICAL();
+
+    uint64_t rtc_mask = bank->rtc_mask;
+    while (rtc_mask) {
+        gpio_num_t gpio_num = (gpio_num_t)__builtin_ctzll(rtc_mask);
+        rtc_mask &= rtc_mask - 1;
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pulldown_dis(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_reset
+* Preconditions: gpio_bank_init, gpio_reset_mask
+* Overview: Funcion que regresa todos los pines del banco a su estado inicial
+* 			(igual que gpio_reset_pin) en una sola pasada.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_reset(const gpio_bank_t *bank)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+    return gpio_reset_mask(bank->mask);
+}
+/**************************************************************************
+* Function: gpio_bank_write
+* Preconditions: gpio_bank_init
+* Overview: Funcion que escribe el nivel de todos los pines de salida del banco,
+* 			una escritura por registro w1ts/w1tc.
+* Input: bank: Descriptor del banco.
+* 		 values: Mascara de 64 bits con el nivel deseado de cada pin.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_write(const gpio_bank_t *bank, uint64_t values)
+{
+    GPIO_CHECK(bank != NULL && bank->mask != 0, "GPIO bank error", ESP_ERR_INVALID_ARG);
+    gpio_hal_write_mask(gpio_context.gpio_hal, bank->output_mask, values);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_bank_read
+* Preconditions: gpio_bank_init
+* Overview: Funcion que lee el nivel de todos los pines del banco en una sola muestra.
+* Input: bank: Descriptor del banco.
+* Output: Niveles de los pines del banco en su posicion de bit (0 si el banco es invalido)
+*
+*****************************************************************************/
+uint64_t gpio_bank_read(const gpio_bank_t *bank)
+{
+    if (bank == NULL) {
+        return 0;
+    }
+    return gpio_hal_get_levels(gpio_context.gpio_hal) & bank->mask;
+}
+/**************************************************************************
+* Function: gpio_act_left_op
+* Preconditions: gpio_get_left_bank, gpio_bank_output_enable
+* Overview: Funcion que activa los pines del lado izquierdo del chip como salidas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_left_op(void){
+	return gpio_bank_output_enable(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_left_op
+* Preconditions: gpio_get_left_bank, gpio_bank_output_disable
+* Overview: Funcion que desactiva los pines del lado izquierdo del chip como salidas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_left_op(void){
+	return gpio_bank_output_disable(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_act_right_op
+* Preconditions: gpio_get_right_bank, gpio_bank_output_enable
+* Overview: Funcion que activa los pines del lado derecho del chip como salidas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_right_op(void){
+	return gpio_bank_output_enable(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_right_op
+* Preconditions: gpio_get_right_bank, gpio_bank_output_disable
+* Overview: Funcion que desactiva los pines del lado derecho del chip como salidas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_right_op(void){
+	return gpio_bank_output_disable(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_act_left_ip
+* Preconditions: gpio_get_left_bank, gpio_bank_input_enable
+* Overview: Funcion que activa los pines del lado izquierdo del chip como entradas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_left_ip(void){
+	return gpio_bank_input_enable(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_left_ip
+* Preconditions: gpio_get_left_bank, gpio_bank_input_disable
+* Overview: Funcion que desactiva los pines del lado izquierdo del chip como entradas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_left_ip(void){
+	return gpio_bank_input_disable(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_act_right_ip
+* Preconditions: gpio_get_right_bank, gpio_bank_input_enable
+* Overview: Funcion que activa los pines del lado derecho del chip como entradas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_right_ip(void){
+	return gpio_bank_input_enable(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_right_ip
+* Preconditions: gpio_get_right_bank, gpio_bank_input_disable
+* Overview: Funcion que desactiva los pines del lado derecho del chip como entradas.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_right_ip(void){
+	return gpio_bank_input_disable(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_act_left_pulldown
+* Preconditions: gpio_get_left_bank, gpio_bank_pulldown_en
+* Overview: Funcion que activa las resistencias de pulldown del lado izquierdo del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_left_pulldown(void){
+	return gpio_bank_pulldown_en(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_left_pulldown
+* Preconditions: gpio_get_left_bank, gpio_bank_pulldown_dis
+* Overview: Funcion que desactiva las resistencias de pulldown del lado izquierdo del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_left_pulldown(void){
+	return gpio_bank_pulldown_dis(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_act_right_pulldown
+* Preconditions: gpio_get_right_bank, gpio_bank_pulldown_en
+* Overview: Funcion que activa las resistencias de pulldown del lado derecho del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_right_pulldown(void){
+	return gpio_bank_pulldown_en(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_right_pulldown
+* Preconditions: gpio_get_right_bank, gpio_bank_pulldown_dis
+* Overview: Funcion que desactiva las resistencias de pulldown del lado derecho del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_right_pulldown(void){
+	return gpio_bank_pulldown_dis(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_act_left_pullup
+* Preconditions: gpio_get_left_bank, gpio_bank_pullup_en
+* Overview: Funcion que activa las resistencias de pullup del lado izquierdo del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_left_pullup(void){
+	return gpio_bank_pullup_en(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_left_pullup
+* Preconditions: gpio_get_left_bank, gpio_bank_pullup_dis
+* Overview: Funcion que desactiva las resistencias de pullup del lado izquierdo del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_left_pullup(void){
+	return gpio_bank_pullup_dis(gpio_get_left_bank());
+}
+/**************************************************************************
+* Function: gpio_act_right_pullup
+* Preconditions: gpio_get_right_bank, gpio_bank_pullup_en
+* Overview: Funcion que activa las resistencias de pullup del lado derecho del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_act_right_pullup(void){
+	return gpio_bank_pullup_en(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_deact_right_pullup
+* Preconditions: gpio_get_right_bank, gpio_bank_pullup_dis
+* Overview: Funcion que desactiva las resistencias de pullup del lado derecho del chip.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_deact_right_pullup(void){
+	return gpio_bank_pullup_dis(gpio_get_right_bank());
+}
+/**************************************************************************
+* Function: gpio_reset_right
+* Preconditions: gpio_reset_mask
+* Overview: Funcion que resetea los pines del lado derecho del chip a su estado default.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_reset_right(void){
+	return gpio_reset_mask(GPIO_HAL_RIGHT_BANK_MASK);
+}
+/**************************************************************************
+* Function: gpio_reset_left
+* Preconditions: gpio_reset_mask
+* Overview: Funcion que resetea los pines del lado izquierdo del chip a su estado default.
+* Output: ESP_OK
+*
+*****************************************************************************/
+esp_err_t gpio_reset_left(void){
+	return gpio_reset_mask(GPIO_HAL_LEFT_BANK_MASK);
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_pullup_en(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        GPIO_ENTER_CRITICAL();
+        gpio_iomux_modify(gpio_num, 0, FUN_PU);
+        GPIO_EXIT_CRITICAL();
+    } else {
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pullup_en(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_pullup_dis(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        GPIO_ENTER_CRITICAL();
+        gpio_iomux_modify(gpio_num, FUN_PU, 0);
+        GPIO_EXIT_CRITICAL();
+    } else {
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pullup_dis(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_pulldown_en(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        GPIO_ENTER_CRITICAL();
+        gpio_iomux_modify(gpio_num, 0, FUN_PD);
+        GPIO_EXIT_CRITICAL();
+    } else {
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pulldown_en(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_pulldown_dis(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        GPIO_ENTER_CRITICAL();
+        gpio_iomux_modify(gpio_num, FUN_PD, 0);
+        GPIO_EXIT_CRITICAL();
+    } else {
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        rtc_gpio_pulldown_dis(gpio_num);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+
+    return ESP_OK;
+}
+// Escribe el tipo de interrupcion del pin y actualiza isr_clr_on_entry_mask. Se llama con el
+// spinlock tomado.
+static void gpio_intr_type_apply(uint32_t gpio_num, gpio_int_type_t intr_type)
+{
+    gpio_hal_set_intr_type(gpio_context.gpio_hal, gpio_num, intr_type);
+    if (intr_type == GPIO_INTR_POSEDGE || intr_type == GPIO_INTR_NEGEDGE || intr_type == GPIO_INTR_ANYEDGE) {
+        gpio_context.isr_clr_on_entry_mask |= (1ULL << (gpio_num));
+    } else {
+        gpio_context.isr_clr_on_entry_mask &= ~(1ULL << (gpio_num));
+    }
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(intr_type < GPIO_INTR_MAX, "GPIO interrupt type error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_intr_type_apply(gpio_num, intr_type);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
+/**************************************************************************
+* Function: gpio_set_intr_priority
+* Overview: Asigna la clase de prioridad del pin. Dentro de una misma entrada al ISR se
+* 			atienden primero los pines CRITICAL, luego HIGH y al final NORMAL; dentro de una
+* 			clase, en orden de numero de pin.
+* Input: gpio_num: Numero de GPIO.
+* 		 prio: Clase de prioridad.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_set_intr_priority(gpio_num_t gpio_num, gpio_intr_prio_t prio)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(prio < GPIO_INTR_PRIO_MAX, "GPIO interrupt priority error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    for (int i = 0; i < GPIO_INTR_PRIO_MAX; i++) {
+        gpio_context.intr_prio_mask[i] &= ~BIT64(gpio_num);
+    }
+    gpio_context.intr_prio_mask[prio] |= BIT64(gpio_num);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
+// Modifica pin[n].int_ena: se llama con el spinlock tomado
+static esp_err_t gpio_intr_enable_on_core(gpio_num_t gpio_num, uint32_t core_id)
+{
+    gpio_hal_intr_enable_on_core(gpio_context.gpio_hal, gpio_num, core_id);
+    return ESP_OK;
+}
+
+// Nucleo que atiende la interrupcion del pin: el fijado con gpio_isr_handler_add_on_core o,
+// si no tiene, el nucleo del servicio de ISR
+static inline uint32_t gpio_intr_core(uint32_t gpio_num)
+{
+    if (gpio_context.intr_affinity_mask & BIT64(gpio_num)) {
+        return (gpio_context.intr_app_cpu_mask & BIT64(gpio_num)) ? 1 : 0;
+    }
+    return gpio_context.isr_core_id;
+}
+
+// Un pin de la cola de eventos solo puede moverse al nucleo que produce los eventos
+static inline bool gpio_event_core_conflict(uint32_t gpio_num, uint32_t core_id)
+{
+    uint64_t event_mask = ((uint64_t)gpio_event_queue.mask_h << 32) | gpio_event_queue.mask;
+    return (event_mask & BIT64(gpio_num)) && core_id != gpio_event_queue.core;
+}
+
+// Indica si la interrupcion del pin tiene algun usuario: handler, handlers encadenados o
+// diferido, o algun servicio que la usa sin handler (cola de eventos, gpio_wait_any,
+// coalescencia, antirrebote). Se llama con el spinlock tomado.
+static bool gpio_intr_in_use(uint32_t gpio_num)
+{
+    uint64_t event_mask = ((uint64_t)gpio_event_queue.mask_h << 32) | gpio_event_queue.mask;
+    uint64_t wait_mask = ((uint64_t)gpio_wait_any_state.mask_h << 32) | gpio_wait_any_state.mask;
+    uint64_t users = event_mask | wait_mask | gpio_context.deferred_mask |
+                     gpio_context.coalesce_mask | gpio_context.debounce_mask;
+    return (users & BIT64(gpio_num)) || gpio_isr_chain[gpio_num] != NULL ||
+           (gpio_context.gpio_isr_func != NULL && GPIO_ISR_FUNC(gpio_num).fn != NULL);
+}
+
+// Deshabilita la interrupcion de los pines que un servicio dejo de usar y que ya no tienen
+// otro usuario. Se llama con el spinlock tomado, despues de actualizar la mascara del servicio.
+static void gpio_intr_release(uint64_t mask)
+{
+    for (; mask; mask &= mask - 1) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        if (!gpio_intr_in_use(gpio_num)) {
+            gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+        }
+    }
+}
+
+// Detiene los timers de rearme de los pines. El llamador ya quito sus bits de throttled_mask en
+// la misma seccion critica en que deshabilito la interrupcion, asi que un callback que ya este
+// corriendo no la vuelve a habilitar; detener el timer evita ademas el reporte de la tormenta.
+// Se llama sin el spinlock tomado.
+static void gpio_throttle_stop(uint64_t throttled)
+{
+    for (; throttled; throttled &= throttled - 1) {
+        esp_timer_stop(gpio_throttle[__builtin_ctzll(throttled)].timer);
+    }
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    if(gpio_context.isr_core_id == GPIO_ISR_CORE_ID_UNINIT) {
+        gpio_context.isr_core_id = xPortGetCoreID();
+    }
+    gpio_context.throttled_mask &= ~BIT64(gpio_num);
+    gpio_context.deferred_masked_mask &= ~BIT64(gpio_num);
+    gpio_intr_enable_on_core (gpio_num, gpio_intr_core(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    uint64_t throttled = gpio_context.throttled_mask & BIT64(gpio_num);
+    gpio_context.throttled_mask &= ~BIT64(gpio_num);
+    gpio_context.deferred_masked_mask &= ~BIT64(gpio_num);
+    gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+    GPIO_EXIT_CRITICAL();
+    gpio_throttle_stop(throttled);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_input_disable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_iomux_modify(gpio_num, FUN_IE, 0);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_input_enable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_iomux_modify(gpio_num, 0, FUN_IE);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_output_disable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    gpio_hal_output_disable(gpio_context.gpio_hal, gpio_num);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_output_enable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO output gpio_num error", ESP_ERR_INVALID_ARG);
+    gpio_hal_output_enable(gpio_context.gpio_hal, gpio_num);
+    esp_rom_gpio_connect_out_signal(gpio_num, SIG_GPIO_OUT_IDX, false, false);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_od_disable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_od_disable(gpio_context.gpio_hal, gpio_num);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_od_enable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_od_enable(gpio_context.gpio_hal, gpio_num);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO output gpio_num error", ESP_ERR_INVALID_ARG);
+    gpio_hal_set_level(gpio_context.gpio_hal, gpio_num, level);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_set_mask
+* Overview: Pone en alto todas las salidas de la mascara con una escritura por registro.
+* Input: mask: Mascara de 64 bits, cada bit se asigna a un GPIO.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_set_mask(uint64_t mask)
+{
+    GPIO_CHECK((mask & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK) == 0, "GPIO output mask error", ESP_ERR_INVALID_ARG);
+    gpio_hal_set_mask(gpio_context.gpio_hal, mask);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_clear_mask
+* Overview: Pone en bajo todas las salidas de la mascara con una escritura por registro.
+* Input: mask: Mascara de 64 bits, cada bit se asigna a un GPIO.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_clear_mask(uint64_t mask)
+{
+    GPIO_CHECK((mask & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK) == 0, "GPIO output mask error", ESP_ERR_INVALID_ARG);
+    gpio_hal_clear_mask(gpio_context.gpio_hal, mask);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_write_mask
+* Overview: Escribe el nivel de todas las salidas de la mascara. Los pines cuyo bit en values
+* 			es 1 quedan en alto y el resto en bajo. Se usan a lo mas cuatro escrituras.
+* Input: mask: Mascara de 64 bits con los pines a modificar.
+* 		 values: Nivel deseado para cada pin (un bit por pin).
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_write_mask(uint64_t mask, uint64_t values)
+{
+    GPIO_CHECK((mask & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK) == 0, "GPIO output mask error", ESP_ERR_INVALID_ARG);
+    gpio_hal_write_mask(gpio_context.gpio_hal, mask, values);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    return gpio_hal_get_level(gpio_context.gpio_hal, gpio_num);
+}
+/**************************************************************************
+* Function: gpio_get_levels
+* Overview: Obtiene una foto coherente del nivel de entrada de los pines de la mascara.
+* 			Todos los pines se muestrean con dos lecturas consecutivas (in e in1).
+* Input: mask: Mascara de 64 bits con los pines de interes.
+* Output: Nivel de entrada de los pines de la mascara (bit n = GPIO n)
+*
+*****************************************************************************/
+
+uint64_t gpio_get_levels(uint64_t mask)
+{
+    return gpio_hal_get_levels(gpio_context.gpio_hal) & mask;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(pull <= GPIO_FLOATING, "GPIO pull mode error", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = ESP_OK;
+
+    switch (pull) {
+        case GPIO_PULLUP_ONLY:
+            gpio_pulldown_dis(gpio_num);
+            gpio_pullup_en(gpio_num);
+            break;
+
+        case GPIO_PULLDOWN_ONLY:
+            gpio_pulldown_en(gpio_num);
+            gpio_pullup_dis(gpio_num);
+            break;
+
+        case GPIO_PULLUP_PULLDOWN:
+            gpio_pulldown_en(gpio_num);
+            gpio_pullup_en(gpio_num);
+            break;
+
+        case GPIO_FLOATING:
+            gpio_pulldown_dis(gpio_num);
+            gpio_pullup_dis(gpio_num);
+            break;
+
+        default:
+            ESP_LOGE(GPIO_TAG, "Unknown pull up/down mode,gpio_num=%u,pull=%u", gpio_num, pull);
+            ret = ESP_ERR_INVALID_ARG;
+            break;
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (mode & GPIO_MODE_DEF_OUTPUT)) {
+        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+
+    if (mode & GPIO_MODE_DEF_INPUT) {
+        gpio_input_enable(gpio_num);
+    } else {
+        gpio_input_disable(gpio_num);
+    }
+
+    if (mode & GPIO_MODE_DEF_OUTPUT) {
+        gpio_output_enable(gpio_num);
+    } else {
+        gpio_output_disable(gpio_num);
+    }
+
+    if (mode & GPIO_MODE_DEF_OD) {
+        gpio_od_enable(gpio_num);
+    } else {
+        gpio_od_disable(gpio_num);
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: gpio_txn_begin
+* Overview: Funcion que deja una transaccion de configuracion sin cambios pendientes.
+* Input: txn: Transaccion.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_begin(gpio_config_txn_t *txn)
+{
+    GPIO_CHECK(txn != NULL, "GPIO transaction error", ESP_ERR_INVALID_ARG);
+    txn->dir_mask = 0;
+    txn->pull_mask = 0;
+    txn->intr_mask = 0;
+    txn->drive_mask = 0;
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_txn_set_direction
+* Preconditions: gpio_txn_begin
+* Overview: Funcion que prepara la direccion de un pin. Los parametros se validan aqui para
+* 			que gpio_txn_commit no pueda fallar a la mitad.
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 mode: Modo del pin.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_direction(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    GPIO_CHECK(txn != NULL, "GPIO transaction error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (mode & GPIO_MODE_DEF_OUTPUT)) {
+        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    txn->pin[gpio_num].mode = (uint8_t)mode;
+    txn->dir_mask |= BIT64(gpio_num);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_txn_set_pull_mode
+* Preconditions: gpio_txn_begin
+* Overview: Funcion que prepara el modo de pull de un pin.
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 pull: Modo de pull.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_pull_mode(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+    GPIO_CHECK(txn != NULL, "GPIO transaction error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(pull <= GPIO_FLOATING, "GPIO pull mode error", ESP_ERR_INVALID_ARG);
+
+    txn->pin[gpio_num].pull = (uint8_t)pull;
+    txn->pull_mask |= BIT64(gpio_num);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_txn_set_intr_type
+* Preconditions: gpio_txn_begin
+* Overview: Funcion que prepara el tipo de interrupcion de un pin.
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 intr_type: Tipo de interrupcion.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_intr_type(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    GPIO_CHECK(txn != NULL, "GPIO transaction error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(intr_type < GPIO_INTR_MAX, "GPIO interrupt type error", ESP_ERR_INVALID_ARG);
+
+    txn->pin[gpio_num].intr_type = (uint8_t)intr_type;
+    txn->intr_mask |= BIT64(gpio_num);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_txn_set_drive_capability
+* Preconditions: gpio_txn_begin
+* Overview: Funcion que prepara la capacidad de drive de un pin.
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 strength: Capacidad del pad.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_drive_capability(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_drive_cap_t strength)
+{
+    GPIO_CHECK(txn != NULL, "GPIO transaction error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(strength < GPIO_DRIVE_CAP_MAX, "GPIO drive capability error", ESP_ERR_INVALID_ARG);
+
+    txn->pin[gpio_num].drive = (uint8_t)strength;
+    txn->drive_mask |= BIT64(gpio_num);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_txn_commit
+* Preconditions: gpio_txn_begin
+* Overview: Funcion que aplica los cambios preparados bajo una sola seccion critica.
+* 			Las salidas que se apagan se deshabilitan primero y las que se encienden al
+* 			final, asi el pin no sale con una configuracion a medias. Cada registro IOMUX
+* 			se escribe una vez y solo si su valor cambia. Los pull y el drive de los
+* 			pads RTC se aplican despues a traves de RTC_IO.
+* Input: txn: Transaccion.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_commit(const gpio_config_txn_t *txn)
+{
+    GPIO_CHECK(txn != NULL, "GPIO transaction error", ESP_ERR_INVALID_ARG);
+
+    uint64_t staged = txn->dir_mask | txn->pull_mask | txn->intr_mask | txn->drive_mask;
+    uint64_t output_on = 0;
+    uint64_t output_off = 0;
+    uint64_t rtc_mask = 0;
+    uint64_t pins = txn->dir_mask;
+
+    while (pins) {
+        uint32_t io_num = __builtin_ctzll(pins);
+        pins &= pins - 1;
+        if (txn->pin[io_num].mode & GPIO_MODE_DEF_OUTPUT) {
+            output_on |= BIT64(io_num);
+        } else {
+            output_off |= BIT64(io_num);
+        }
+    }
+
+    pins = txn->pull_mask | txn->drive_mask;
+    while (pins && !SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        uint32_t io_num = __builtin_ctzll(pins);
+        pins &= pins - 1;
+        if (rtc_gpio_is_valid_gpio(io_num)) {
+            rtc_mask |= BIT64(io_num);
+        }
+    }
+
+    GPIO_ENTER_CRITICAL();
+    if (output_off) {
+        gpio_hal_output_disable_mask(gpio_context.gpio_hal, output_off);
+    }
+
+    pins = staged;
+    while (pins) {
+        uint32_t io_num = __builtin_ctzll(pins);
+        uint64_t bit = BIT64(io_num);
+        uint32_t clr_bits = 0;
+        uint32_t set_bits = 0;
+        pins &= pins - 1;
+
+        if (txn->dir_mask & bit) {
+            clr_bits |= FUN_IE;
+            set_bits |= (txn->pin[io_num].mode & GPIO_MODE_DEF_INPUT) ? FUN_IE : 0;
+            if (txn->pin[io_num].mode & GPIO_MODE_DEF_OD) {
+                gpio_hal_od_enable(gpio_context.gpio_hal, io_num);
+            } else {
+                gpio_hal_od_disable(gpio_context.gpio_hal, io_num);
+            }
+        }
+        if ((txn->pull_mask & bit) && !(rtc_mask & bit)) {
+            uint8_t pull = txn->pin[io_num].pull;
+            clr_bits |= FUN_PU | FUN_PD;
+            set_bits |= (pull == GPIO_PULLUP_ONLY || pull == GPIO_PULLUP_PULLDOWN) ? FUN_PU : 0;
+            set_bits |= (pull == GPIO_PULLDOWN_ONLY || pull == GPIO_PULLUP_PULLDOWN) ? FUN_PD : 0;
+        }
+        if ((txn->drive_mask & bit) && !(rtc_mask & bit)) {
+            clr_bits |= FUN_DRV;
+            set_bits |= ((uint32_t)txn->pin[io_num].drive << FUN_DRV_S) & FUN_DRV;
+        }
+        if (clr_bits) {
+            uint32_t cur = gpio_iomux_load(io_num);
+            if (((cur & ~clr_bits) | set_bits) != cur) {
+                gpio_iomux_modify(io_num, clr_bits, set_bits);
+            }
+        }
+
+        if (txn->intr_mask & bit) {
+            gpio_int_type_t intr_type = (gpio_int_type_t)txn->pin[io_num].intr_type;
+            gpio_hal_set_intr_type(gpio_context.gpio_hal, io_num, intr_type);
+            if (intr_type == GPIO_INTR_POSEDGE || intr_type == GPIO_INTR_NEGEDGE || intr_type == GPIO_INTR_ANYEDGE) {
+                gpio_context.isr_clr_on_entry_mask |= bit;
+            } else {
+                gpio_context.isr_clr_on_entry_mask &= ~bit;
+            }
+        }
+    }
+
+    if (output_on) {
+        gpio_hal_connect_gpio_out_mask(gpio_context.gpio_hal, output_on);
+        gpio_hal_output_enable_mask(gpio_context.gpio_hal, output_on);
+    }
+    GPIO_EXIT_CRITICAL();
+
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+    pins = rtc_mask;
+    while (pins) {
+        gpio_num_t gpio_num = (gpio_num_t)__builtin_ctzll(pins);
+        uint64_t bit = BIT64(gpio_num);
+        pins &= pins - 1;
+
+        if (txn->pull_mask & bit) {
+            uint8_t pull = txn->pin[gpio_num].pull;
+            if (pull == GPIO_PULLUP_ONLY || pull == GPIO_PULLUP_PULLDOWN) {
+                rtc_gpio_pullup_en(gpio_num);
+            } else {
+                rtc_gpio_pullup_dis(gpio_num);
+            }
+            if (pull == GPIO_PULLDOWN_ONLY || pull == GPIO_PULLUP_PULLDOWN) {
+                rtc_gpio_pulldown_en(gpio_num);
+            } else {
+                rtc_gpio_pulldown_dis(gpio_num);
+            }
+        }
+        if (txn->drive_mask & bit) {
+            rtc_gpio_set_drive_capability(gpio_num, (gpio_drive_cap_t)txn->pin[gpio_num].drive);
+        }
+    }
+#else
+    assert(rtc_mask == 0);
+#endif
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_state_save
+* Overview: Funcion que guarda en state la configuracion de los pines de la mascara. La muestra
+* 			se toma bajo el spinlock, asi todos los pines pertenecen al mismo instante.
+* Input: mask: Mascara de 64 bits con los pines a guardar.
+* 		 state: Estructura donde se guarda el estado.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_state_save(uint64_t mask, gpio_state_t *state)
+{
+    GPIO_CHECK(state != NULL, "GPIO state error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(mask != 0 && (mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+
+    uint32_t idx = 0;
+    uint64_t pins = mask;
+
+    GPIO_ENTER_CRITICAL();
+    state->mask = mask;
+    state->output_enable = gpio_hal_get_output_enable(gpio_context.gpio_hal) & mask;
+    state->output_level = gpio_hal_get_output_levels(gpio_context.gpio_hal) & mask;
+    state->edge_mask = gpio_context.isr_clr_on_entry_mask & mask;
+    while (pins) {
+        uint32_t io_num = __builtin_ctzll(pins);
+        pins &= pins - 1;
+        state->pin[idx].pad = gpio_iomux_load(io_num);
+        state->pin[idx].pin = gpio_hal_get_pin_config(gpio_context.gpio_hal, io_num);
+        state->pin[idx].out_sel = gpio_hal_get_out_sel_config(gpio_context.gpio_hal, io_num);
+        idx++;
+    }
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_state_restore
+* Preconditions: gpio_state_save
+* Overview: Funcion que regresa los pines al estado guardado escribiendo solo los registros que
+* 			difieren. Las salidas que deben apagarse se deshabilitan primero y las que deben
+* 			encenderse al final, despues de restaurar pad, enrutamiento y nivel.
+* Input: state: Estado guardado.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_state_restore(const gpio_state_t *state)
+{
+    GPIO_CHECK(state != NULL, "GPIO state error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(state->mask != 0 && (state->mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+
+    uint64_t mask = state->mask;
+    uint32_t idx = 0;
+    uint64_t pins = mask;
+
+    GPIO_ENTER_CRITICAL();
+    uint64_t enable_diff = (gpio_hal_get_output_enable(gpio_context.gpio_hal) ^ state->output_enable) & mask;
+    if (enable_diff & ~state->output_enable) {
+        gpio_hal_output_enable_clear_mask(gpio_context.gpio_hal, enable_diff & ~state->output_enable);
+    }
+
+    while (pins) {
+        uint32_t io_num = __builtin_ctzll(pins);
+        pins &= pins - 1;
+        if (gpio_iomux_load(io_num) != state->pin[idx].pad) {
+            gpio_iomux_modify(io_num, UINT32_MAX, state->pin[idx].pad);
+        }
+        if (gpio_hal_get_pin_config(gpio_context.gpio_hal, io_num) != state->pin[idx].pin) {
+            gpio_hal_set_pin_config(gpio_context.gpio_hal, io_num, state->pin[idx].pin);
+        }
+        if (gpio_hal_get_out_sel_config(gpio_context.gpio_hal, io_num) != state->pin[idx].out_sel) {
+            gpio_hal_set_out_sel_config(gpio_context.gpio_hal, io_num, state->pin[idx].out_sel);
+        }
+        idx++;
+    }
+    gpio_context.isr_clr_on_entry_mask = (gpio_context.isr_clr_on_entry_mask & ~mask) | state->edge_mask;
+
+    uint64_t level_diff = (gpio_hal_get_output_levels(gpio_context.gpio_hal) ^ state->output_level) & mask;
+    if (level_diff) {
+        gpio_hal_write_mask(gpio_context.gpio_hal, level_diff, state->output_level);
+    }
+    if (enable_diff & state->output_enable) {
+        gpio_hal_output_enable_mask(gpio_context.gpio_hal, enable_diff & state->output_enable);
+    }
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_config(const gpio_config_t *pGPIOConfig)
+{
+    uint64_t gpio_pin_mask = (pGPIOConfig->pin_bit_mask);
+    uint32_t io_reg = 0;
+    uint32_t io_num = 0;
+    uint8_t input_en = 0;
+    uint8_t output_en = 0;
+    uint8_t od_en = 0;
+    uint8_t pu_en = 0;
+    uint8_t pd_en = 0;
+
+    if (pGPIOConfig->pin_bit_mask == 0 ||
+        pGPIOConfig->pin_bit_mask & ~SOC_GPIO_VALID_GPIO_MASK) {
+        ESP_LOGE(GPIO_TAG, "GPIO_PIN mask error ");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (pGPIOConfig->mode & GPIO_MODE_DEF_OUTPUT &&
+        pGPIOConfig->pin_bit_mask & ~SOC_GPIO_VALID_OUTPUT_GPIO_MASK) {
+        ESP_LOGE(GPIO_TAG, "GPIO can only be used as input mode");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if ((pGPIOConfig->mode) & GPIO_MODE_DEF_INPUT) {
+        input_en = 1;
+    }
+    if ((pGPIOConfig->mode) & GPIO_MODE_DEF_OD) {
+        od_en = 1;
+    }
+    if ((pGPIOConfig->mode) & GPIO_MODE_DEF_OUTPUT) {
+        output_en = 1;
+    }
+    if (pGPIOConfig->pull_up_en) {
+        pu_en = 1;
+    }
+    if (pGPIOConfig->pull_down_en) {
+        pd_en = 1;
+    }
+
+    /* Todos los pines quedan como GPIO; entrada y pulls se fijan en la misma escritura IOMUX */
+    uint32_t iomux_set = (PIN_FUNC_GPIO << MCU_SEL_S) | (input_en ? FUN_IE : 0);
+    uint32_t pull_set = (pu_en ? FUN_PU : 0) | (pd_en ? FUN_PD : 0);
+
+    // Solo se visitan los bits activos de la mascara
+    uint64_t throttled = 0;
+    while (gpio_pin_mask) {
+        io_num = __builtin_ctzll(gpio_pin_mask);
+        gpio_pin_mask &= gpio_pin_mask - 1;
+        io_reg = GPIO_PIN_MUX_REG[io_num];
+        assert(io_reg != (intptr_t)NULL);
+
+        // Las resistencias de los pads RTC se controlan desde RTC_IO, no desde IOMUX
+        bool rtc_pull = false;
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        if (rtc_gpio_is_valid_gpio(io_num)) {
+            rtc_gpio_deinit(io_num);
+            rtc_pull = !SOC_GPIO_SUPPORT_RTC_INDEPENDENT;
+        }
+#endif
+
+        GPIO_ENTER_CRITICAL();
+        if (rtc_pull) {
+            gpio_iomux_modify(io_num, MCU_SEL | FUN_IE, iomux_set);
+        } else {
+            gpio_iomux_modify(io_num, MCU_SEL | FUN_IE | FUN_PU | FUN_PD, iomux_set | pull_set);
+        }
+        if (od_en) {
+            gpio_hal_od_enable(gpio_context.gpio_hal, io_num);
+        } else {
+            gpio_hal_od_disable(gpio_context.gpio_hal, io_num);
+        }
+        // Tipo e int_ena en la misma seccion critica, igual que gpio_intr_enable/disable
+        gpio_intr_type_apply(io_num, pGPIOConfig->intr_type);
+        throttled |= gpio_context.throttled_mask & BIT64(io_num);
+        gpio_context.throttled_mask &= ~BIT64(io_num);
+        gpio_context.deferred_masked_mask &= ~BIT64(io_num);
+        if (pGPIOConfig->intr_type) {
+            if (gpio_context.isr_core_id == GPIO_ISR_CORE_ID_UNINIT) {
+                gpio_context.isr_core_id = xPortGetCoreID();
+            }
+            gpio_intr_enable_on_core(io_num, gpio_intr_core(io_num));
+            throttled &= ~BIT64(io_num);
+        } else {
+            gpio_hal_intr_disable(gpio_context.gpio_hal, io_num);
+        }
+        GPIO_EXIT_CRITICAL();
+
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        if (rtc_pull) {
+            if (pu_en) {
+                rtc_gpio_pullup_en(io_num);
+            } else {
+                rtc_gpio_pullup_dis(io_num);
+            }
+            if (pd_en) {
+                rtc_gpio_pulldown_en(io_num);
+            } else {
+                rtc_gpio_pulldown_dis(io_num);
+            }
+        }
+#endif
+
+        ESP_LOGD(GPIO_TAG, "GPIO[%"PRIu32"]| InputEn: %d| OutputEn: %d| OpenDrain: %d| Pullup: %d| Pulldown: %d| Intr:%d ", io_num, input_en, output_en, od_en, pu_en, pd_en, pGPIOConfig->intr_type);
+    }
+    gpio_throttle_stop(throttled);
+
+    // La habilitacion de salida se escribe una vez por registro para toda la mascara
+    if (output_en) {
+        gpio_hal_output_enable_mask(gpio_context.gpio_hal, pGPIOConfig->pin_bit_mask);
+        gpio_hal_connect_gpio_out_mask(gpio_context.gpio_hal, pGPIOConfig->pin_bit_mask);
+    } else {
+        gpio_hal_output_disable_mask(gpio_context.gpio_hal, pGPIOConfig->pin_bit_mask);
+    }
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+    assert(GPIO_IS_VALID_GPIO(gpio_num));
+    gpio_reset_mask(BIT64(gpio_num));
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_reset_mask
+* Overview: Funcion que regresa todos los pines de la mascara a su estado inicial en una
+* 			sola pasada: funcion GPIO, entrada y salida deshabilitadas, pullup activo,
+* 			open-drain e interrupcion deshabilitados. Solo se visitan los bits activos y la
+* 			salida se deshabilita con una escritura por registro. Los pines salen tambien de
+* 			los servicios que usan su interrupcion (rearme del limite de eventos, handlers
+* 			diferidos y encadenados, cola de eventos, gpio_wait_any, coalescencia y
+* 			antirrebote).
+* Input: mask: Mascara de 64 bits con los pines a reiniciar.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+static void gpio_isr_chain_sync(void);
+
+esp_err_t gpio_reset_mask(uint64_t mask)
+{
+    GPIO_CHECK(mask != 0 && (mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+
+    uint64_t throttled = 0;
+    bool event_emptied = false;     // se quito el ultimo pin de la cola de eventos
+    bool wait_emptied = false;      // se quito el ultimo pin de gpio_wait_any
+    gpio_isr_chain_node_t *chain[GPIO_NUM_MAX] = {0};
+    uint64_t pins = mask;
+    while (pins) {
+        uint32_t io_num = __builtin_ctzll(pins);
+        pins &= pins - 1;
+        assert(GPIO_PIN_MUX_REG[io_num] != 0);
+
+        bool rtc_pull = false;
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        if (rtc_gpio_is_valid_gpio(io_num)) {
+            rtc_gpio_deinit(io_num);
+            rtc_pull = !SOC_GPIO_SUPPORT_RTC_INDEPENDENT;
+        }
+#endif
+
+        GPIO_ENTER_CRITICAL();
+        //for powersave reasons, the GPIO should not be floating, select pullup
+        if (rtc_pull) {
+            gpio_iomux_modify(io_num, MCU_SEL | FUN_IE, PIN_FUNC_GPIO << MCU_SEL_S);
+        } else {
+            gpio_iomux_modify(io_num, MCU_SEL | FUN_IE | FUN_PU | FUN_PD, (PIN_FUNC_GPIO << MCU_SEL_S) | FUN_PU);
+        }
+        gpio_hal_od_disable(gpio_context.gpio_hal, io_num);
+        gpio_hal_set_intr_type(gpio_context.gpio_hal, io_num, GPIO_INTR_DISABLE);
+        gpio_hal_intr_disable(gpio_context.gpio_hal, io_num);
+        throttled |= gpio_context.throttled_mask & BIT64(io_num);
+        gpio_context.throttled_mask &= ~BIT64(io_num);
+        // Sin handler diferido el ISR deja de enviar el pin a la tarea y la tarea no vuelve a
+        // habilitar su interrupcion
+        gpio_context.deferred_mask &= ~BIT64(io_num);
+        gpio_context.deferred_masked_mask &= ~BIT64(io_num);
+        gpio_deferred.func[io_num].fn = NULL;
+        gpio_deferred.func[io_num].args = NULL;
+        // Antirrebote: un vencimiento pendiente ya no entrega el evento del pin
+        gpio_context.debounce_mask &= ~BIT64(io_num);
+        gpio_debounce.armed &= ~BIT64(io_num);
+        gpio_debounce.callback[io_num] = NULL;
+        gpio_debounce.arg[io_num] = NULL;
+        gpio_context.coalesce_mask &= ~BIT64(io_num);
+        for (int i = 0; i < CONFIG_GPIO_COALESCE_GROUPS; i++) {
+            gpio_coalesce[i].mask &= ~BIT64(io_num);
+        }
+        bool event_had = (gpio_event_queue.mask | gpio_event_queue.mask_h) != 0;
+        bool wait_had = (gpio_wait_any_state.mask | gpio_wait_any_state.mask_h) != 0;
+        if (io_num < 32) {
+            __atomic_store_n(&gpio_event_queue.mask, gpio_event_queue.mask & ~BIT(io_num), __ATOMIC_RELEASE);
+            __atomic_store_n(&gpio_wait_any_state.mask, gpio_wait_any_state.mask & ~BIT(io_num), __ATOMIC_RELEASE);
+        } else {
+            __atomic_store_n(&gpio_event_queue.mask_h, gpio_event_queue.mask_h & ~BIT(io_num - 32), __ATOMIC_RELEASE);
+            __atomic_store_n(&gpio_wait_any_state.mask_h, gpio_wait_any_state.mask_h & ~BIT(io_num - 32), __ATOMIC_RELEASE);
+        }
+        event_emptied |= event_had && (gpio_event_queue.mask | gpio_event_queue.mask_h) == 0;
+        wait_emptied |= wait_had && (gpio_wait_any_state.mask | gpio_wait_any_state.mask_h) == 0;
+        // Los nodos encadenados se desenlazan aqui y se liberan despues de gpio_isr_chain_sync
+        chain[io_num] = gpio_isr_chain[io_num];
+        __atomic_store_n(&gpio_isr_chain[io_num], NULL, __ATOMIC_RELEASE);
+        GPIO_EXIT_CRITICAL();
+
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        if (rtc_pull) {
+            rtc_gpio_pullup_en(io_num);
+            rtc_gpio_pulldown_dis(io_num);
+        }
+#endif
+    }
+
+    GPIO_ENTER_CRITICAL();
+    gpio_context.isr_clr_on_entry_mask &= ~mask;
+    GPIO_EXIT_CRITICAL();
+    gpio_throttle_stop(throttled);
+    gpio_hal_output_disable_mask(gpio_context.gpio_hal, mask);
+
+    // Sin pines, la cola de eventos y gpio_wait_any se quitan y despiertan a su tarea
+    if (event_emptied) {
+        gpio_event_queue_uninstall();
+    }
+    if (wait_emptied) {
+        gpio_wait_any_cancel();
+    }
+    gpio_isr_chain_sync();
+    GPIO_ENTER_CRITICAL();
+    for (pins = mask; pins; pins &= pins - 1) {
+        for (gpio_isr_chain_node_t *node = chain[__builtin_ctzll(pins)]; node != NULL; node = node->next) {
+            node->in_use = false;
+        }
+    }
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_deferred_latch
+* Preconditions: Llamada solo desde el servicio de ISR, para pines de deferred_mask
+* Overview: Parte rapida de los handlers diferidos: deshabilita los pines por nivel, guarda la
+* 			marca de tiempo de entrada, marca los pines como pendientes y notifica a la tarea.
+* Input: core_id: Nucleo que atiende la interrupcion.
+* 		 pending: Mascara de 64 bits con los pines diferidos que generaron evento.
+* 		 task_woken: Se pone en pdTRUE si se desperto una tarea de mayor prioridad.
+*
+*****************************************************************************/
+static inline void IRAM_ATTR gpio_deferred_latch(uint32_t core_id, uint64_t pending, BaseType_t *task_woken)
+{
+    uint64_t level = pending & ~gpio_context.isr_clr_on_entry_mask;
+    if (level) {
+        GPIO_ENTER_CRITICAL_ISR();
+        gpio_context.deferred_masked_mask |= level;
+        for (uint64_t pins = level; pins; pins &= pins - 1) {
+            gpio_hal_intr_disable(gpio_context.gpio_hal, __builtin_ctzll(pins));
+        }
+        GPIO_EXIT_CRITICAL_ISR();
+    }
+    for (uint64_t pins = pending; pins; pins &= pins - 1) {
+        gpio_deferred.time[__builtin_ctzll(pins)] = gpio_context.isr_entry[core_id];
+    }
+    __atomic_fetch_or(&gpio_deferred.pending, (uint32_t)pending, __ATOMIC_RELEASE);
+    __atomic_fetch_or(&gpio_deferred.pending_h, (uint32_t)(pending >> 32), __ATOMIC_RELEASE);
+    vTaskNotifyGiveFromISR(gpio_deferred.task, task_woken);
+}
+/**************************************************************************
+* Function: gpio_coalesce_latch
+* Preconditions: Llamada solo desde el servicio de ISR, para pines de coalesce_mask
+* Overview: Suma los eventos al lote de su grupo: OR de pines, conteo por pin y marcas de tiempo
+* 			del primero y del ultimo. Arranca el timer de la ventana con el primer evento y lo
+* 			adelanta cuando el lote llega a max_events.
+* Input: core_id: Nucleo que atiende la interrupcion.
+* 		 pending: Mascara de 64 bits con los pines agrupados que generaron evento.
+*
+*****************************************************************************/
+static inline void IRAM_ATTR gpio_coalesce_latch(uint32_t core_id, uint64_t pending)
+{
+    for (int i = 0; i < CONFIG_GPIO_COALESCE_GROUPS && pending; i++) {
+        gpio_coalesce_group_t *group = &gpio_coalesce[i];
+        uint64_t pins = pending & group->mask;
+        if (pins == 0) {
+            continue;
+        }
+        pending &= ~pins;
+
+        GPIO_ENTER_CRITICAL_ISR();
+        gpio_coalesce_batch_t *batch = &group->batch;
+        uint32_t before = batch->total;
+        bool start = (before == 0);
+        if (start) {
+            batch->first = gpio_context.isr_entry[core_id];
+        }
+        batch->last = gpio_context.isr_entry[core_id];
+        batch->pending_mask |= pins;
+        for (; pins; pins &= pins - 1) {
+            uint32_t gpio_num = __builtin_ctzll(pins);
+            if (batch->count[gpio_num] != UINT16_MAX) {
+                batch->count[gpio_num]++;
+            }
+            batch->total++;
+        }
+        // Solo el evento que cruza max_events adelanta el timer
+        bool full = (group->max_events != 0 && before < group->max_events &&
+                     batch->total >= group->max_events);
+        // Se lee con el spinlock: NULL si gpio_coalesce_group_remove ya reclamo el timer
+        esp_timer_handle_t timer = group->timer;
+        GPIO_EXIT_CRITICAL_ISR();
+
+        if (timer == NULL) {
+            continue;
+        }
+        if (full) {
+            esp_timer_stop(timer);
+            esp_timer_start_once(timer, 0);
+        } else if (start) {
+            esp_timer_start_once(timer, group->window_us);
+        }
+    }
+}
+/**************************************************************************
+* Function: gpio_debounce_latch
+* Preconditions: Llamada solo desde el servicio de ISR, para pines de debounce_mask
+* Overview: Arma los pines que tuvieron flanco con vencimiento ahora + stable_us y adelanta el
+* 			timer compartido si alguno vence antes de lo programado.
+* Input: core_id: Nucleo que atiende la interrupcion.
+* 		 pending: Mascara de 64 bits con los pines con antirrebote que generaron evento.
+*
+*****************************************************************************/
+static inline void IRAM_ATTR gpio_debounce_latch(uint32_t core_id, uint64_t pending)
+{
+    int64_t now = gpio_context.isr_entry[core_id].time_us;
+    int64_t earliest = 0;
+
+    GPIO_ENTER_CRITICAL_ISR();
+    gpio_debounce.armed |= pending;
+    for (; pending; pending &= pending - 1) {
+        uint32_t gpio_num = __builtin_ctzll(pending);
+        int64_t deadline = now + gpio_debounce.stable_us[gpio_num];
+        gpio_debounce.deadline[gpio_num] = deadline;
+        if (earliest == 0 || deadline < earliest) {
+            earliest = deadline;
+        }
+    }
+    bool restart = (gpio_debounce.timer_deadline == 0 || earliest < gpio_debounce.timer_deadline);
+    if (restart) {
+        gpio_debounce.timer_deadline = earliest;
+    }
+    GPIO_EXIT_CRITICAL_ISR();
+
+    if (restart) {
+        esp_timer_stop(gpio_debounce.timer);
+        esp_timer_start_once(gpio_debounce.timer, earliest - now);
+    }
+}
+/**************************************************************************
+* Function: gpio_throttle_check
+* Preconditions: Llamada solo desde el servicio de ISR, para pines de throttle_mask
+* Overview: Cuenta un evento en la ventana del pin. Si se pasa del limite deshabilita la
+* 			interrupcion del pin y arranca el timer de rearme. Tiempo constante.
+* Input: gpio_num: Numero de GPIO.
+* 		 now: Tiempo de entrada al ISR en microsegundos (32 bits bajos).
+*
+*****************************************************************************/
+static inline void IRAM_ATTR gpio_throttle_check(uint32_t gpio_num, uint32_t now)
+{
+    gpio_throttle_t *throttle = &gpio_throttle[gpio_num];
+    if (now - throttle->window_start >= throttle->window_us) {
+        if (throttle->count <= throttle->max_events) {
+            throttle->backoff_shift = 0;
+        }
+        throttle->window_start = now;
+        throttle->count = 0;
+    }
+    if (++throttle->count <= throttle->max_events) {
+        return;
+    }
+
+    GPIO_ENTER_CRITICAL_ISR();
+    gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+    gpio_context.throttled_mask |= BIT64(gpio_num);
+    GPIO_EXIT_CRITICAL_ISR();
+    throttle->last_backoff = throttle->backoff_us << throttle->backoff_shift;
+    if (throttle->backoff_shift < GPIO_THROTTLE_MAX_SHIFT) {
+        throttle->backoff_shift++;
+    }
+    throttle->storms++;
+    esp_timer_start_once(throttle->timer, throttle->last_backoff);
+}
+#if CONFIG_GPIO_ISR_STATS
+/**************************************************************************
+* Function: gpio_isr_stats_record
+* Preconditions: Llamada solo desde el servicio de ISR
+* Overview: Suma un evento a las estadisticas del pin: conteo, ciclos min/max/total del handler
+* 			y el histograma log2 (la casilla i cuenta duraciones de 2^i a 2^(i+1)-1 ciclos).
+* Input: gpio_num: Numero de GPIO.
+* 		 cycles: Ciclos de CPU que tardo el handler.
+* 		 coalesced: true si la misma entrada al ISR atendio tambien otros pines.
+*
+*****************************************************************************/
+static inline void IRAM_ATTR gpio_isr_stats_record(uint32_t gpio_num, uint32_t cycles, bool coalesced)
+{
+    gpio_isr_stats_entry_t *entry = &gpio_isr_stats[gpio_num];
+    gpio_isr_pin_stats_t *stats = &entry->stats;
+    uint32_t bin = cycles ? 31 - __builtin_clz(cycles) : 0;
+    if (bin >= GPIO_ISR_STATS_HIST_BINS) {
+        bin = GPIO_ISR_STATS_HIST_BINS - 1;
+    }
+
+    __atomic_store_n(&entry->seq, entry->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    if (entry->reset) {
+        *stats = (gpio_isr_pin_stats_t) {0};
+        entry->reset = 0;
+    }
+    if (stats->count == 0 || cycles < stats->min_cycles) {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->count++;
+    stats->coalesced += coalesced;
+    stats->total_cycles += cycles;
+    stats->hist[bin]++;
+    __atomic_store_n(&entry->seq, entry->seq + 1, __ATOMIC_RELEASE);
+}
+#endif
+/**************************************************************************
+* Function: gpio_isr_loop
+* Overview: Ejecuta los handlers (el de gpio_isr_handler_add y los encadenados) de cada pin de
+* 			la mascara, en orden de numero de pin.
+* Input: pending: Mascara de 64 bits con los pines a atender.
+* 		 coalesced: true si la misma entrada al ISR atiende varios pines (estadisticas).
+*
+*****************************************************************************/
+
+static inline void IRAM_ATTR gpio_isr_loop(uint64_t pending, bool coalesced)
+{
+    while (pending) {
+        uint32_t gpio_num = __builtin_ctzll(pending);
+        pending &= pending - 1;
+
+        gpio_isr_chain_node_t *node = __atomic_load_n(&gpio_isr_chain[gpio_num], __ATOMIC_ACQUIRE);
+        if (GPIO_ISR_FUNC(gpio_num).fn != NULL || node != NULL) {
+#if CONFIG_GPIO_ISR_STATS
+            uint32_t start = esp_cpu_get_cycle_count();
+#endif
+            if (GPIO_ISR_FUNC(gpio_num).fn != NULL) {
+                GPIO_ISR_FUNC(gpio_num).fn(GPIO_ISR_FUNC(gpio_num).args);
+            }
+            for (; node != NULL; node = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)) {
+                node->fn(node->args);
+            }
+#if CONFIG_GPIO_ISR_STATS
+            gpio_isr_stats_record(gpio_num, esp_cpu_get_cycle_count() - start, coalesced);
+#endif
+        }
+    }
+}
+/**************************************************************************
+* Function: gpio_event_push
+* Preconditions: Llamada solo desde gpio_intr_service
+* Overview: Guarda en la cola un evento por cada pin de pending, con el nivel de una sola
+* 			lectura del registro de entrada. Si la cola esta llena el evento se cuenta como
+* 			descartado. Si se guardo algun evento notifica a la tarea lectora, solo si esta
+* 			bloqueada.
+* Input: core_id: Nucleo que atiende la interrupcion.
+* 		 pending: Mascara de 64 bits con los pines que generaron evento.
+* 		 task_woken: Se pone en pdTRUE si se desperto una tarea de mayor prioridad.
+*
+*****************************************************************************/
+static inline void IRAM_ATTR gpio_event_push(uint32_t core_id, uint64_t pending, BaseType_t *task_woken)
+{
+    uint64_t levels = gpio_hal_get_levels(gpio_context.gpio_hal);
+    uint32_t start = gpio_event_queue.head;
+    uint32_t head = start;
+    uint32_t tail = __atomic_load_n(&gpio_event_queue.tail, __ATOMIC_ACQUIRE);
+
+    while (pending) {
+        uint32_t gpio_num = __builtin_ctzll(pending);
+        pending &= pending - 1;
+        if (head - tail >= CONFIG_GPIO_EVENT_QUEUE_LEN) {
+            __atomic_fetch_add(&gpio_event_queue.dropped, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+        gpio_event_t *event = &gpio_event_queue.events[head & (CONFIG_GPIO_EVENT_QUEUE_LEN - 1)];
+        event->gpio_num = gpio_num;
+        event->level = (levels >> gpio_num) & 0x1;
+        event->cycles = gpio_context.isr_entry[core_id].cycles;
+        event->timestamp = gpio_context.isr_entry[core_id].time_us;
+        head++;
+    }
+    if (head - tail > gpio_event_queue.high_water) {
+        gpio_event_queue.high_water = head - tail;
+    }
+    if (head == start) {
+        return;
+    }
+    __atomic_store_n(&gpio_event_queue.head, head, __ATOMIC_RELEASE);
+
+    GPIO_ENTER_CRITICAL_ISR();
+    TaskHandle_t reader = gpio_event_queue.waiting;
+    gpio_event_queue.waiting = NULL;
+    if (reader != NULL) {
+        vTaskNotifyGiveFromISR(reader, task_woken);
+    }
+    GPIO_EXIT_CRITICAL_ISR();
+}
+/**************************************************************************
+* Function: gpio_intr_service
+* Overview: Rutina de servicio de interrupcion del GPIO. Se toma la marca de tiempo de entrada,
+* 			se leen los dos registros de estado, se limpian juntos los pines por flanco (una
+* 			escritura por registro), se cuentan los eventos de los pines con limite, se pasan
+* 			los pines diferidos a su tarea, se atienden los manejadores CRITICAL y HIGH, se
+* 			acumulan los lotes de coalescencia, se arma el antirrebote, se atienden los NORMAL
+* 			y al final se limpian juntos los pines por nivel.
+* Input: arg: Nucleo en el que se instalo esta instancia del servicio; solo se lee el
+* 		 registro de estado de ese nucleo.
+*
+*****************************************************************************/
+
+static void IRAM_ATTR gpio_intr_service(void *arg)
+{
+    uint32_t core_id = (uint32_t)(uintptr_t)arg;
+    // Marca de tiempo antes de cualquier otro trabajo; el contador de ciclos va primero porque
+    // esp_timer_get_time tarda mas en leerse
+    gpio_context.isr_entry[core_id].cycles = esp_cpu_get_cycle_count();
+    gpio_context.isr_entry[core_id].time_us = esp_timer_get_time();
+
+    //GPIO intr process
+    if (gpio_context.gpio_isr_func == NULL) {
+        return;
+    }
+
+    //read status to get interrupt status for GPIO0-31 and status1 for GPIO32-39
+    uint32_t gpio_intr_status;
+    uint32_t gpio_intr_status_h;
+    gpio_hal_get_intr_status(gpio_context.gpio_hal, core_id, &gpio_intr_status);
+    gpio_hal_get_intr_status_high(gpio_context.gpio_hal, core_id, &gpio_intr_status_h);
+
+    // Edge-triggered type interrupts can clear the interrupt status bits before entering per-pin handlers
+    uint64_t clr_on_entry = gpio_context.isr_clr_on_entry_mask;
+    uint32_t edge_status = gpio_intr_status & (uint32_t)clr_on_entry;
+    uint32_t edge_status_h = gpio_intr_status_h & (uint32_t)(clr_on_entry >> 32);
+    if (edge_status) {
+        gpio_hal_clear_intr_status(gpio_context.gpio_hal, edge_status);
+    }
+    if (edge_status_h) {
+        gpio_hal_clear_intr_status_high(gpio_context.gpio_hal, edge_status_h);
+    }
+
+    // Desde aqui el ISR usa mascaras y handlers publicados por las tareas (gpio_isr_chain_sync)
+    __atomic_store_n(&gpio_context.isr_seq[core_id], gpio_context.isr_seq[core_id] + 1, __ATOMIC_RELEASE);
+
+    BaseType_t task_woken = pdFALSE;
+    uint32_t event_status = gpio_intr_status & gpio_event_queue.mask;
+    uint32_t event_status_h = gpio_intr_status_h & gpio_event_queue.mask_h;
+    if (event_status | event_status_h) {
+        gpio_event_push(core_id, ((uint64_t)event_status_h << 32) | event_status, &task_woken);
+    }
+
+    uint32_t wait_status = gpio_intr_status & gpio_wait_any_state.mask;
+    uint32_t wait_status_h = gpio_intr_status_h & gpio_wait_any_state.mask_h;
+    if (wait_status | wait_status_h) {
+        __atomic_fetch_or(&gpio_wait_any_state.fired, wait_status, __ATOMIC_RELEASE);
+        __atomic_fetch_or(&gpio_wait_any_state.fired_h, wait_status_h, __ATOMIC_RELEASE);
+        GPIO_ENTER_CRITICAL_ISR();
+        TaskHandle_t waiter = gpio_wait_any_state.waiting;
+        gpio_wait_any_state.waiting = NULL;
+        if (waiter != NULL) {
+            vTaskNotifyGiveFromISR(waiter, &task_woken);
+        }
+        GPIO_EXIT_CRITICAL_ISR();
+    }
+
+    uint64_t limited = (((uint64_t)gpio_intr_status_h << 32) | gpio_intr_status) & gpio_context.throttle_mask;
+    while (limited) {
+        gpio_throttle_check(__builtin_ctzll(limited), (uint32_t)gpio_context.isr_entry[core_id].time_us);
+        limited &= limited - 1;
+    }
+
+    uint64_t deferred = (((uint64_t)gpio_intr_status_h << 32) | gpio_intr_status) & gpio_context.deferred_mask;
+    if (deferred) {
+        gpio_deferred_latch(core_id, deferred, &task_woken);
+    }
+
+#if CONFIG_GPIO_ISR_STATS
+    bool coalesced = (__builtin_popcount(gpio_intr_status) + __builtin_popcount(gpio_intr_status_h)) > 1;
+#else
+    bool coalesced = false;
+#endif
+    // Primero las clases de prioridad mas alta; cada clase es un AND con su mascara precalculada
+    uint64_t pending = ((uint64_t)gpio_intr_status_h << 32) | gpio_intr_status;
+    for (int prio = GPIO_INTR_PRIO_MAX - 1; prio > GPIO_INTR_PRIO_NORMAL; prio--) {
+        uint64_t class_pending = pending & gpio_context.intr_prio_mask[prio];
+        pending &= ~class_pending;
+        gpio_isr_loop(class_pending, coalesced);
+    }
+
+    // Los lotes y el antirrebote toman el spinlock y mueven timers: van despues de las clases
+    // CRITICAL y HIGH
+    uint64_t coalesce = (((uint64_t)gpio_intr_status_h << 32) | gpio_intr_status) & gpio_context.coalesce_mask;
+    if (coalesce) {
+        gpio_coalesce_latch(core_id, coalesce);
+    }
+
+    uint64_t debounce = (((uint64_t)gpio_intr_status_h << 32) | gpio_intr_status) & gpio_context.debounce_mask;
+    if (debounce) {
+        gpio_debounce_latch(core_id, debounce);
+    }
+
+    gpio_isr_loop(pending, coalesced);
+    __atomic_store_n(&gpio_context.isr_seq[core_id], gpio_context.isr_seq[core_id] + 1, __ATOMIC_RELEASE);
+
+    // Level-triggered type interrupts must be cleared after the handlers have run
+    if (gpio_intr_status & ~edge_status) {
+        gpio_hal_clear_intr_status(gpio_context.gpio_hal, gpio_intr_status & ~edge_status);
+    }
+    if (gpio_intr_status_h & ~edge_status_h) {
+        gpio_hal_clear_intr_status_high(gpio_context.gpio_hal, gpio_intr_status_h & ~edge_status_h);
+    }
+
+    if (task_woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_isr_register_on_core(void (*fn)(void *), void *arg, int intr_alloc_flags, gpio_isr_handle_t *handle, uint32_t core_id);
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func == NULL, "GPIO isr service already installed", ESP_ERR_INVALID_STATE);
+    esp_err_t ret;
+#if CONFIG_GPIO_ISR_STATIC_TABLE
+    gpio_isr_func_t *isr_func = gpio_isr_func_table;
+#else
+    // La reserva de memoria se hace fuera de la seccion critica; solo se publica el puntero dentro
+    gpio_isr_func_t *isr_func = (gpio_isr_func_t *) calloc(GPIO_NUM_MAX, sizeof(gpio_isr_func_t));
+    if (isr_func == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+#endif
+    GPIO_ENTER_CRITICAL();
+    if (gpio_context.gpio_isr_func == NULL) {
+        gpio_context.gpio_isr_func = isr_func;
+        isr_func = NULL;
+    }
+    if (gpio_context.isr_core_id == GPIO_ISR_CORE_ID_UNINIT) {
+        gpio_context.isr_core_id = xPortGetCoreID();
+    }
+    uint32_t core_id = gpio_context.isr_core_id;
+    GPIO_EXIT_CRITICAL();
+    if (isr_func != NULL) {
+#if !CONFIG_GPIO_ISR_STATIC_TABLE
+        free(isr_func);
+#endif
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        ret = gpio_isr_register_on_core(gpio_intr_service, (void *)(uintptr_t)core_id, intr_alloc_flags,
+                                        &gpio_context.gpio_isr_handle[core_id], core_id);
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: gpio_install_isr_service_per_core
+* Overview: Instala el servicio de ISR en el nucleo que llama y ademas en los demas nucleos.
+* 			Cada instancia lee solo el registro de estado de su nucleo, asi que los pines
+* 			enrutados con gpio_isr_handler_add_on_core a un nucleo no agregan latencia al otro.
+* Input: intr_alloc_flags: Las banderas usadas para colocar la interrupcion.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_NO_MEM: Memoria insuficiente
+* 		  ESP_ERR_INVALID_STATE: El servicio ya esta instalado
+* 		  ESP_ERR_NOT_FOUND: No se encontro una interrupcion libre en algun nucleo
+*
+*****************************************************************************/
+
+esp_err_t gpio_install_isr_service_per_core(int intr_alloc_flags)
+{
+    esp_err_t ret = gpio_install_isr_service(intr_alloc_flags);
+    for (uint32_t core_id = 0; ret == ESP_OK && core_id < portNUM_PROCESSORS; core_id++) {
+        if (core_id == gpio_context.isr_core_id) {
+            continue;
+        }
+        ret = gpio_isr_register_on_core(gpio_intr_service, (void *)(uintptr_t)core_id, intr_alloc_flags,
+                                        &gpio_context.gpio_isr_handle[core_id], core_id);
+        if (ret != ESP_OK) {
+            gpio_uninstall_isr_service();
+        }
+    }
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    if (gpio_event_core_conflict(gpio_num, gpio_context.isr_core_id)) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO event pins must stay on the event queue core");
+        return ESP_ERR_INVALID_STATE;
+    }
+    gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+    if (gpio_context.gpio_isr_func) {
+        GPIO_ISR_FUNC(gpio_num).fn = isr_handler;
+        GPIO_ISR_FUNC(gpio_num).args = args;
+    }
+    gpio_context.deferred_mask &= ~BIT64(gpio_num);
+    gpio_context.deferred_masked_mask &= ~BIT64(gpio_num);
+    gpio_context.intr_affinity_mask &= ~BIT64(gpio_num);
+    gpio_intr_enable_on_core (gpio_num, gpio_context.isr_core_id);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_isr_handler_add_on_core
+* Preconditions: gpio_install_isr_service_per_core (o gpio_install_isr_service si core_id es
+* 				 el nucleo del servicio)
+* Overview: Igual que gpio_isr_handler_add pero la interrupcion del pin se enruta al nucleo
+* 			indicado. El nucleo queda fijo aunque despues se llame gpio_intr_enable o gpio_config.
+* Input: gpio_num: Numero del GPIO.
+* 		 isr_handler: Funcion del handler de ISR.
+* 		 args: parametro para el handler del ISR.
+* 		 core_id: Nucleo que atiende la interrupcion del pin.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio no esta instalado en ese nucleo
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_handler_add_on_core(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args, uint32_t core_id)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(core_id < portNUM_PROCESSORS, "core id error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(gpio_context.gpio_isr_handle[core_id] != NULL, "GPIO isr service is not installed on this core, call gpio_install_isr_service_per_core() first", ESP_ERR_INVALID_STATE);
+    GPIO_ENTER_CRITICAL();
+    if (gpio_event_core_conflict(gpio_num, core_id)) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO event pins must stay on the event queue core");
+        return ESP_ERR_INVALID_STATE;
+    }
+    gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+    GPIO_ISR_FUNC(gpio_num).fn = isr_handler;
+    GPIO_ISR_FUNC(gpio_num).args = args;
+    gpio_context.deferred_mask &= ~BIT64(gpio_num);
+    gpio_context.deferred_masked_mask &= ~BIT64(gpio_num);
+    gpio_context.intr_affinity_mask |= BIT64(gpio_num);
+    if (core_id == 1) {
+        gpio_context.intr_app_cpu_mask |= BIT64(gpio_num);
+    } else {
+        gpio_context.intr_app_cpu_mask &= ~BIT64(gpio_num);
+    }
+    gpio_intr_enable_on_core (gpio_num, core_id);
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_deferred_task
+* Overview: Tarea de handlers diferidos. Toma juntos todos los pines pendientes y ejecuta el
+* 			handler de cada uno con la marca de tiempo guardada por el ISR; despues vuelve a
+* 			habilitar los pines por nivel que el ISR deshabilito.
+* Input: arg: No se usa.
+*
+*****************************************************************************/
+
+static void gpio_deferred_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint64_t pending = __atomic_exchange_n(&gpio_deferred.pending, 0, __ATOMIC_ACQUIRE);
+        pending |= (uint64_t)__atomic_exchange_n(&gpio_deferred.pending_h, 0, __ATOMIC_ACQUIRE) << 32;
+
+        while (pending) {
+            uint32_t gpio_num = __builtin_ctzll(pending);
+            pending &= pending - 1;
+
+            GPIO_ENTER_CRITICAL();
+            gpio_deferred_func_t func = gpio_deferred.func[gpio_num];
+            gpio_isr_timestamp_t time = gpio_deferred.time[gpio_num];
+            GPIO_EXIT_CRITICAL();
+            if (func.fn != NULL) {
+                func.fn(gpio_num, &time, func.args);
+            }
+
+            GPIO_ENTER_CRITICAL();
+            if (gpio_context.deferred_masked_mask & BIT64(gpio_num)) {
+                gpio_context.deferred_masked_mask &= ~BIT64(gpio_num);
+                gpio_intr_enable_on_core(gpio_num, gpio_intr_core(gpio_num));
+            }
+            GPIO_EXIT_CRITICAL();
+        }
+    }
+}
+/**************************************************************************
+* Function: gpio_isr_handler_add_deferred
+* Preconditions: gpio_install_isr_service
+* Overview: Registra un handler que se ejecuta en la tarea de handlers diferidos en lugar de
+* 			dentro del ISR. La tarea se crea la primera vez con prioridad
+* 			CONFIG_GPIO_DEFERRED_TASK_PRIORITY.
+* Input: gpio_num: Numero del GPIO.
+* 		 handler: Funcion que se ejecuta en la tarea.
+* 		 args: parametro para el handler.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado o el pin es de la
+* 		  						 cola de eventos y se atiende en otro nucleo
+* 		  ESP_ERR_NO_MEM: No se pudo crear la tarea
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_handler_add_deferred(gpio_num_t gpio_num, gpio_deferred_handler_t handler, void *args)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(handler != NULL, "GPIO deferred handler null", ESP_ERR_INVALID_ARG);
+
+    // La tarea se crea fuera de la seccion critica; solo se publica el handle dentro
+    if (gpio_deferred.task == NULL) {
+        TaskHandle_t task = NULL;
+        GPIO_CHECK(xTaskCreate(gpio_deferred_task, "gpio_deferred", CONFIG_GPIO_DEFERRED_TASK_STACK, NULL,
+                               CONFIG_GPIO_DEFERRED_TASK_PRIORITY, &task) == pdPASS,
+                   "GPIO deferred task create failed", ESP_ERR_NO_MEM);
+        GPIO_ENTER_CRITICAL();
+        if (gpio_deferred.task == NULL) {
+            gpio_deferred.task = task;
+            task = NULL;
+        }
+        GPIO_EXIT_CRITICAL();
+        if (task != NULL) {
+            vTaskDelete(task);
+        }
+    }
+
+    GPIO_ENTER_CRITICAL();
+    if (gpio_event_core_conflict(gpio_num, gpio_intr_core(gpio_num))) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO event pins must stay on the event queue core");
+        return ESP_ERR_INVALID_STATE;
+    }
+    gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+    GPIO_ISR_FUNC(gpio_num).fn = NULL;
+    GPIO_ISR_FUNC(gpio_num).args = NULL;
+    gpio_deferred.func[gpio_num].fn = handler;
+    gpio_deferred.func[gpio_num].args = args;
+    gpio_context.deferred_mask |= BIT64(gpio_num);
+    gpio_context.deferred_masked_mask &= ~BIT64(gpio_num);
+    gpio_intr_enable_on_core(gpio_num, gpio_intr_core(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    // Los handlers encadenados del pin siguen activos
+    uint64_t throttled = 0;
+    if (gpio_isr_chain[gpio_num] == NULL) {
+        gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+        gpio_context.intr_affinity_mask &= ~BIT64(gpio_num);
+        throttled = gpio_context.throttled_mask & BIT64(gpio_num);
+        gpio_context.throttled_mask &= ~BIT64(gpio_num);
+    }
+    if (gpio_context.gpio_isr_func) {
+        GPIO_ISR_FUNC(gpio_num).fn = NULL;
+        GPIO_ISR_FUNC(gpio_num).args = NULL;
+    }
+    gpio_context.deferred_mask &= ~BIT64(gpio_num);
+    gpio_context.deferred_masked_mask &= ~BIT64(gpio_num);
+    GPIO_EXIT_CRITICAL();
+    gpio_throttle_stop(throttled);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_isr_chain_sync
+* Overview: Espera a que ningun nucleo este recorriendo handlers con una lista o una mascara
+* 			vieja: si el ISR de un nucleo estaba atendiendo, se espera a que termine esa entrada.
+* 			No debe llamarse con el spinlock tomado.
+*
+*****************************************************************************/
+
+static void gpio_isr_chain_sync(void)
+{
+    for (int core_id = 0; core_id < portNUM_PROCESSORS; core_id++) {
+        uint32_t seq = __atomic_load_n(&gpio_context.isr_seq[core_id], __ATOMIC_ACQUIRE);
+        if (seq & 0x1) {
+            while (__atomic_load_n(&gpio_context.isr_seq[core_id], __ATOMIC_ACQUIRE) == seq) {
+            }
+        }
+    }
+}
+/**************************************************************************
+* Function: gpio_isr_handler_chain_add
+* Preconditions: gpio_install_isr_service
+* Overview: Agrega un handler mas al pin sin reemplazar los que ya tiene. Se ejecutan despues
+* 			del handler de gpio_isr_handler_add, de mayor a menor prioridad; con la misma
+* 			prioridad, en orden de registro. El nodo sale de un arreglo estatico.
+* Input: gpio_num: Numero del GPIO.
+* 		 isr_handler: Funcion del handler.
+* 		 args: parametro para el handler.
+* 		 priority: Prioridad del handler, mayor se ejecuta antes.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado o el pin es de la
+* 		  						 cola de eventos y se atiende en otro nucleo
+* 		  ESP_ERR_NO_MEM: No quedan nodos libres (CONFIG_GPIO_ISR_CHAIN_POOL_SIZE)
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_handler_chain_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args, uint8_t priority)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(isr_handler != NULL, "GPIO ISR null", ESP_ERR_INVALID_ARG);
+    gpio_isr_chain_node_t *node = NULL;
+
+    GPIO_ENTER_CRITICAL();
+    if (gpio_event_core_conflict(gpio_num, gpio_intr_core(gpio_num))) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO event pins must stay on the event queue core");
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (int i = 0; i < CONFIG_GPIO_ISR_CHAIN_POOL_SIZE; i++) {
+        if (!gpio_isr_chain_pool[i].in_use) {
+            node = &gpio_isr_chain_pool[i];
+            break;
+        }
+    }
+    if (node == NULL) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO isr chain pool exhausted");
+        return ESP_ERR_NO_MEM;
+    }
+    node->in_use = true;
+    node->fn = isr_handler;
+    node->args = args;
+    node->priority = priority;
+
+    gpio_isr_chain_node_t **link = &gpio_isr_chain[gpio_num];
+    while (*link != NULL && (*link)->priority >= priority) {
+        link = &(*link)->next;
+    }
+    node->next = *link;
+    __atomic_store_n(link, node, __ATOMIC_RELEASE);
+    gpio_intr_enable_on_core(gpio_num, gpio_intr_core(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_isr_handler_chain_remove
+* Preconditions: gpio_isr_handler_chain_add
+* Overview: Quita del pin el handler encadenado con la misma funcion y parametro. Puede
+* 			llamarse mientras el ISR esta activo en cualquier nucleo: el nodo se desenlaza con el
+* 			spinlock y se libera despues de gpio_isr_chain_sync. Si la interrupcion del pin se
+* 			queda sin usuarios (handlers ni servicios que la usan) se deshabilita.
+* Input: gpio_num: Numero del GPIO.
+* 		 isr_handler: Funcion del handler.
+* 		 args: parametro con el que se registro.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado
+* 		  ESP_ERR_NOT_FOUND: El handler no estaba registrado en el pin
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_handler_chain_remove(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    gpio_isr_chain_node_t *node = NULL;
+
+    GPIO_ENTER_CRITICAL();
+    gpio_isr_chain_node_t **link = &gpio_isr_chain[gpio_num];
+    while (*link != NULL) {
+        if ((*link)->fn == isr_handler && (*link)->args == args) {
+            node = *link;
+            __atomic_store_n(link, node->next, __ATOMIC_RELEASE);
+            break;
+        }
+        link = &(*link)->next;
+    }
+    if (node != NULL && !gpio_intr_in_use(gpio_num)) {
+        gpio_hal_intr_disable(gpio_context.gpio_hal, gpio_num);
+    }
+    GPIO_EXIT_CRITICAL();
+    if (node == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // El nodo puede seguir en uso por un ISR que lo leyo antes de desenlazarlo
+    gpio_isr_chain_sync();
+    GPIO_ENTER_CRITICAL();
+    node->in_use = false;
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_isr_get_timestamp
+* Preconditions: Llamada desde un handler de gpio_isr_handler_add
+* Overview: Copia la marca de tiempo que tomo gpio_intr_service al entrar.
+* Input: timestamp: Apuntador donde se guarda la marca.
+*
+*****************************************************************************/
+
+void IRAM_ATTR gpio_isr_get_timestamp(gpio_isr_timestamp_t *timestamp)
+{
+    *timestamp = gpio_context.isr_entry[xPortGetCoreID()];
+}
+/**************************************************************************
+* Function: gpio_event_queue_install
+* Preconditions: gpio_install_isr_service
+* Overview: Descarta los eventos pendientes, reinicia los contadores y publica la mascara de
+* 			pines que generan eventos.
+* Input: mask: Mascara de 64 bits con los pines que generan eventos.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_event_queue_install(uint64_t mask)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(mask != 0 && (mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+    uint64_t pins = mask;
+    uint32_t core_id = gpio_intr_core(__builtin_ctzll(pins));
+    while (pins) {
+        GPIO_CHECK(gpio_intr_core(__builtin_ctzll(pins)) == core_id, "GPIO event pins must be serviced on one core", ESP_ERR_INVALID_ARG);
+        pins &= pins - 1;
+    }
+    gpio_event_queue_uninstall();
+    gpio_event_queue.core = core_id;
+    gpio_event_queue.dropped = 0;
+    gpio_event_queue.high_water = 0;
+    __atomic_store_n(&gpio_event_queue.mask_h, (uint32_t)(mask >> 32), __ATOMIC_RELEASE);
+    __atomic_store_n(&gpio_event_queue.mask, (uint32_t)mask, __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_event_queue_uninstall
+* Overview: Quita la mascara de eventos, descarta los pendientes y deshabilita la interrupcion
+* 			de los pines sin otro usuario, todo en una seccion critica. Espera al ISR que leyo
+* 			la mascara vieja y despierta a la tarea bloqueada en gpio_event_read, que regresa
+* 			con ESP_ERR_INVALID_STATE.
+*
+*****************************************************************************/
+
+void gpio_event_queue_uninstall(void)
+{
+    GPIO_ENTER_CRITICAL();
+    uint64_t old_mask = ((uint64_t)gpio_event_queue.mask_h << 32) | gpio_event_queue.mask;
+    TaskHandle_t waiter = gpio_event_queue.waiting;
+    gpio_event_queue.mask = 0;
+    gpio_event_queue.mask_h = 0;
+    gpio_event_queue.waiting = NULL;
+    gpio_intr_release(old_mask);
+    GPIO_EXIT_CRITICAL();
+
+    // Un ISR que leyo la mascara vieja puede seguir escribiendo eventos: se descartan despues
+    gpio_isr_chain_sync();
+    GPIO_ENTER_CRITICAL();
+    __atomic_store_n(&gpio_event_queue.tail, __atomic_load_n(&gpio_event_queue.head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+    GPIO_EXIT_CRITICAL();
+
+    // La tarea vio waiting en NULL y espera esta notificacion antes de regresar
+    if (waiter != NULL) {
+        xTaskNotifyGive(waiter);
+    }
+}
+/**************************************************************************
+* Function: gpio_event_read
+* Preconditions: gpio_event_queue_install
+* Overview: Saca el evento mas antiguo de la cola. Si esta vacia, la tarea se publica en
+* 			waiting con el spinlock y espera con ulTaskNotifyTake; el ISR que escribe un evento
+* 			la quita de waiting al notificarla. Una notificacion que llega despues del timeout
+* 			se consume antes de regresar, asi que no despierta otras esperas de la tarea.
+* Input: event: Apuntador donde se guarda el evento.
+* 		 timeout: Tiempo maximo de espera en ticks.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_TIMEOUT: No llego ningun evento en el tiempo de espera
+* 		  ESP_ERR_INVALID_STATE: La cola no esta instalada, se quito durante la espera u otra
+* 		  						 tarea ya espera
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_event_read(gpio_event_t *event, TickType_t timeout)
+{
+    GPIO_CHECK(event != NULL, "event pointer error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK((gpio_event_queue.mask | gpio_event_queue.mask_h) != 0, "GPIO event queue is not installed", ESP_ERR_INVALID_STATE);
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    GPIO_ENTER_CRITICAL();
+    bool busy = (gpio_event_queue.waiting != NULL && gpio_event_queue.waiting != task);
+    GPIO_EXIT_CRITICAL();
+    GPIO_CHECK(!busy, "GPIO event queue already has a waiting task", ESP_ERR_INVALID_STATE);
+
+    TimeOut_t time_out;
+    vTaskSetTimeOutState(&time_out);
+    bool armed = false;     // se publico waiting antes del ultimo ulTaskNotifyTake
+    bool took = false;      // el ultimo ulTaskNotifyTake consumio una notificacion
+    while (1) {
+        bool timed_out = (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE);
+
+        GPIO_ENTER_CRITICAL();
+        bool installed = (gpio_event_queue.mask | gpio_event_queue.mask_h) != 0;
+        uint32_t tail = gpio_event_queue.tail;
+        bool ready = installed && __atomic_load_n(&gpio_event_queue.head, __ATOMIC_ACQUIRE) != tail;
+        if (ready) {
+            *event = gpio_event_queue.events[tail & (CONFIG_GPIO_EVENT_QUEUE_LEN - 1)];
+            __atomic_store_n(&gpio_event_queue.tail, tail + 1, __ATOMIC_RELEASE);
+        }
+        // Si waiting ya no esta, el ISR o gpio_event_queue_uninstall lo tomo y hay exactamente
+        // una notificacion para esta tarea
+        bool given = armed && gpio_event_queue.waiting == NULL;
+        bool wait = (!ready && !timed_out && installed);
+        gpio_event_queue.waiting = wait ? task : NULL;
+        GPIO_EXIT_CRITICAL();
+
+        if (given && !took) {
+            // La notificacion llego despues de que ulTaskNotifyTake vencio: se consume aqui
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        if (!wait) {
+            if (ready) {
+                return ESP_OK;
+            }
+            return installed ? ESP_ERR_TIMEOUT : ESP_ERR_INVALID_STATE;
+        }
+        armed = true;
+        took = (ulTaskNotifyTake(pdTRUE, timeout) != 0);
+    }
+}
+/**************************************************************************
+* Function: gpio_event_get_stats
+* Overview: Copia los contadores de la cola de eventos y opcionalmente los reinicia.
+* Input: stats: Apuntador donde se guardan los contadores.
+* 		 reset: true para reiniciar los contadores.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_event_get_stats(gpio_event_stats_t *stats, bool reset)
+{
+    GPIO_CHECK(stats != NULL, "stats pointer error", ESP_ERR_INVALID_ARG);
+    if (reset) {
+        stats->dropped = __atomic_exchange_n(&gpio_event_queue.dropped, 0, __ATOMIC_RELAXED);
+        stats->high_water = __atomic_exchange_n(&gpio_event_queue.high_water, 0, __ATOMIC_RELAXED);
+    } else {
+        stats->dropped = __atomic_load_n(&gpio_event_queue.dropped, __ATOMIC_RELAXED);
+        stats->high_water = __atomic_load_n(&gpio_event_queue.high_water, __ATOMIC_RELAXED);
+    }
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_throttle_rearm
+* Overview: Callback del timer de rearme (tarea de esp_timer). Reporta la tormenta, limpia el
+* 			estado pendiente del pin, abre una ventana nueva y vuelve a habilitar la
+* 			interrupcion, salvo que mientras tanto se haya llamado gpio_intr_enable/disable.
+* Input: arg: Numero de GPIO.
+*
+*****************************************************************************/
+
+static void gpio_throttle_rearm(void *arg)
+{
+    uint32_t gpio_num = (uint32_t)(uintptr_t)arg;
+    gpio_throttle_t *throttle = &gpio_throttle[gpio_num];
+    bool rearmed = false;
+
+    GPIO_ENTER_CRITICAL();
+    if (gpio_context.throttled_mask & BIT64(gpio_num)) {
+        gpio_context.throttled_mask &= ~BIT64(gpio_num);
+        throttle->window_start = (uint32_t)esp_timer_get_time();
+        throttle->count = 0;
+        if (gpio_num < 32) {
+            gpio_hal_clear_intr_status(gpio_context.gpio_hal, BIT(gpio_num));
+        } else {
+            gpio_hal_clear_intr_status_high(gpio_context.gpio_hal, BIT(gpio_num - 32));
+        }
+        gpio_intr_enable_on_core(gpio_num, gpio_intr_core(gpio_num));
+        rearmed = true;
+    }
+    GPIO_EXIT_CRITICAL();
+    if (rearmed) {
+        ESP_LOGW(GPIO_TAG, "GPIO[%"PRIu32"] interrupt storm, re-armed after %"PRIu32" us (%"PRIu32" storms)",
+                 gpio_num, throttle->last_backoff, throttle->storms);
+    }
+}
+/**************************************************************************
+* Function: gpio_intr_set_rate_limit
+* Overview: Configura el limite de eventos de interrupcion de un pin. Si en una ventana de
+* 			window_us llegan mas de max_events eventos, la interrupcion del pin se deshabilita y
+* 			se rearma despues de backoff_us (duplicandose en tormentas seguidas). La ventana se
+* 			reinicia con el pin fuera de throttle_mask y sin ISR en curso.
+* Input: gpio_num: Numero de GPIO.
+* 		 max_events: Eventos permitidos por ventana, 0 para quitar el limite.
+* 		 window_us: Duracion de la ventana en microsegundos.
+* 		 backoff_us: Espera base antes de rearmar en microsegundos.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_NO_MEM: No se pudo crear el timer de rearme
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_intr_set_rate_limit(gpio_num_t gpio_num, uint32_t max_events, uint32_t window_us, uint32_t backoff_us)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(max_events == 0 || (window_us > 0 && backoff_us > 0), "GPIO rate limit error", ESP_ERR_INVALID_ARG);
+    gpio_throttle_t *throttle = &gpio_throttle[gpio_num];
+
+    esp_timer_handle_t timer = NULL;
+    if (max_events != 0 && throttle->timer == NULL) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = gpio_throttle_rearm,
+            .arg = (void *)(uintptr_t)gpio_num,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "gpio_throttle",
+        };
+        GPIO_CHECK(esp_timer_create(&timer_args, &timer) == ESP_OK, "GPIO throttle timer create failed", ESP_ERR_NO_MEM);
+    }
+
+    // El timer se publica con el spinlock; si otra llamada ya publico uno, se borra el propio.
+    // El pin sale de throttle_mask para que el ISR deje de tocar su ventana mientras se reinicia
+    GPIO_ENTER_CRITICAL();
+    if (timer != NULL && throttle->timer == NULL) {
+        throttle->timer = timer;
+        timer = NULL;
+    }
+    gpio_context.throttle_mask &= ~BIT64(gpio_num);
+    GPIO_EXIT_CRITICAL();
+    if (timer != NULL) {
+        esp_timer_delete(timer);
+    }
+    gpio_isr_chain_sync();
+
+    GPIO_ENTER_CRITICAL();
+    throttle->max_events = max_events;
+    throttle->window_us = window_us;
+    throttle->backoff_us = backoff_us;
+    throttle->window_start = (uint32_t)esp_timer_get_time();
+    throttle->count = 0;
+    throttle->backoff_shift = 0;
+    if (max_events != 0) {
+        gpio_context.throttle_mask |= BIT64(gpio_num);
+    }
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_intr_get_throttled_mask
+* Overview: Devuelve los pines cuya interrupcion esta deshabilitada por el limite de eventos.
+* Output: Mascara de 64 bits con los pines deshabilitados.
+*
+*****************************************************************************/
+
+uint64_t gpio_intr_get_throttled_mask(void)
+{
+    GPIO_ENTER_CRITICAL();
+    uint64_t mask = gpio_context.throttled_mask;
+    GPIO_EXIT_CRITICAL();
+    return mask;
+}
+/**************************************************************************
+* Function: gpio_intr_get_storm_count
+* Overview: Devuelve cuantas veces el limite de eventos deshabilito la interrupcion del pin.
+* Input: gpio_num: Numero de GPIO.
+* Output: Numero de tormentas, 0 si el pin no es valido.
+*
+*****************************************************************************/
+
+uint32_t gpio_intr_get_storm_count(gpio_num_t gpio_num)
+{
+    if (!GPIO_IS_VALID_GPIO(gpio_num)) {
+        return 0;
+    }
+    return gpio_throttle[gpio_num].storms;
+}
+/**************************************************************************
+* Function: gpio_wait_isr_handler
+* Overview: Handler de gpio_wait_edge: guarda la marca de tiempo de entrada al ISR y notifica
+* 			directamente a la tarea que espera.
+* Input: arg: Numero de GPIO.
+*
+*****************************************************************************/
+
+static void IRAM_ATTR gpio_wait_isr_handler(void *arg)
+{
+    gpio_wait_t *wait = &gpio_wait[(uint32_t)(uintptr_t)arg];
+    BaseType_t task_woken = pdFALSE;
+
+    GPIO_ENTER_CRITICAL_ISR();
+    if (wait->task != NULL && !wait->fired) {
+        gpio_isr_get_timestamp(&wait->time);
+        wait->fired = true;
+        TaskHandle_t waiter = wait->waiting;
+        wait->waiting = NULL;
+        if (waiter != NULL) {
+            vTaskNotifyGiveFromISR(waiter, &task_woken);
+        }
+    }
+    GPIO_EXIT_CRITICAL_ISR();
+    if (task_woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+/**************************************************************************
+* Function: gpio_wait_edge
+* Preconditions: gpio_install_isr_service
+* Overview: Bloquea la tarea hasta el siguiente flanco del pin. Si la interrupcion del pin no
+* 			tiene otro usuario configura el tipo de interrupcion y lo restaura al regresar; si
+* 			lo tiene, el tipo debe ser ya edge. Limpia el estado pendiente y encadena
+* 			gpio_wait_isr_handler con gpio_isr_handler_chain_add, sin tocar los handlers ni
+* 			servicios que ya usan el pin. Espera con el mismo protocolo de waiting que
+* 			gpio_wait_any, asi que no consume ni deja notificaciones ajenas a la espera.
+* Input: gpio_num: Numero de GPIO.
+* 		 edge: GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE o GPIO_INTR_ANYEDGE.
+* 		 timeout: Tiempo maximo de espera en ticks.
+* 		 timestamp: Donde se guarda la marca de tiempo del flanco, puede ser NULL.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_TIMEOUT: No hubo flanco en el tiempo de espera
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no esta instalado, otra tarea ya espera el
+* 		  						 pin o el pin esta en uso con otro tipo de interrupcion
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_wait_edge(gpio_num_t gpio_num, gpio_int_type_t edge, TickType_t timeout, gpio_isr_timestamp_t *timestamp)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(edge == GPIO_INTR_POSEDGE || edge == GPIO_INTR_NEGEDGE || edge == GPIO_INTR_ANYEDGE, "GPIO edge type error", ESP_ERR_INVALID_ARG);
+    gpio_wait_t *wait = &gpio_wait[gpio_num];
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    GPIO_ENTER_CRITICAL();
+    if (wait->task != NULL) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO[%d] already has a waiting task", gpio_num);
+        return ESP_ERR_INVALID_STATE;
+    }
+    // Otro usuario del pin depende de su tipo de interrupcion: no se cambia mientras se espera
+    gpio_int_type_t prev_type = gpio_hal_get_intr_type(gpio_context.gpio_hal, gpio_num);
+    bool retype = (prev_type != edge);
+    if (retype && gpio_intr_in_use(gpio_num)) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO[%d] is in use with another interrupt type", gpio_num);
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (retype) {
+        gpio_intr_type_apply(gpio_num, edge);
+    }
+    wait->task = task;
+    wait->waiting = NULL;
+    wait->fired = false;
+    GPIO_EXIT_CRITICAL();
+
+    // Se descarta un flanco anterior a la llamada
+    if (gpio_num < 32) {
+        gpio_hal_clear_intr_status(gpio_context.gpio_hal, BIT(gpio_num));
+    } else {
+        gpio_hal_clear_intr_status_high(gpio_context.gpio_hal, BIT(gpio_num - 32));
+    }
+    esp_err_t ret = gpio_isr_handler_chain_add(gpio_num, gpio_wait_isr_handler, (void *)(uintptr_t)gpio_num, 0);
+
+    if (ret == ESP_OK) {
+        TimeOut_t time_out;
+        vTaskSetTimeOutState(&time_out);
+        bool armed = false;     // se publico waiting antes del ultimo ulTaskNotifyTake
+        bool took = false;      // el ultimo ulTaskNotifyTake consumio una notificacion
+        while (1) {
+            bool timed_out = (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE);
+
+            GPIO_ENTER_CRITICAL();
+            // Si waiting ya no esta, el handler lo tomo y hay exactamente una notificacion
+            bool given = armed && wait->waiting == NULL;
+            bool block = (!wait->fired && !timed_out);
+            wait->waiting = block ? task : NULL;
+            GPIO_EXIT_CRITICAL();
+
+            if (given && !took) {
+                // La notificacion llego despues de que ulTaskNotifyTake vencio: se consume aqui
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            if (!block) {
+                break;
+            }
+            armed = true;
+            took = (ulTaskNotifyTake(pdTRUE, timeout) != 0);
+        }
+        // Regresa despues de gpio_isr_chain_sync: ningun ISR sigue dentro del handler. Un
+        // flanco despues del timeout ya no notifica porque waiting quedo en NULL
+        gpio_isr_handler_chain_remove(gpio_num, gpio_wait_isr_handler, (void *)(uintptr_t)gpio_num);
+        ret = ESP_ERR_TIMEOUT;
+    }
+
+    GPIO_ENTER_CRITICAL();
+    // Un usuario que llego durante la espera se queda con el tipo con el que se registro
+    if (retype && !gpio_intr_in_use(gpio_num)) {
+        gpio_intr_type_apply(gpio_num, prev_type);
+    }
+    if (wait->fired) {
+        ret = ESP_OK;
+        if (timestamp != NULL) {
+            *timestamp = wait->time;
+        }
+    }
+    wait->task = NULL;
+    GPIO_EXIT_CRITICAL();
+    return ret;
+}
+/**************************************************************************
+* Function: gpio_wait_any
+* Preconditions: gpio_install_isr_service y tipo de interrupcion configurado en los pines
+* Overview: Bloquea la tarea hasta que dispare cualquier pin de la mascara y devuelve todos los
+* 			que dispararon desde la llamada anterior. Si la mascara cambia, la tarea que llama
+* 			queda como la que espera, se descarta lo acumulado y se habilita la interrupcion
+* 			de los pines.
+* Input: mask: Mascara de 64 bits con los pines a vigilar.
+* 		 timeout: Tiempo maximo de espera en ticks.
+* 		 fired_mask: Donde se guardan los pines que dispararon.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_TIMEOUT: Ningun pin disparo en el tiempo de espera
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado, otra tarea ya
+* 		  						 espera o la espera se cancelo con gpio_wait_any_cancel
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_wait_any(uint64_t mask, TickType_t timeout, uint64_t *fired_mask)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(mask != 0 && (mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(fired_mask != NULL, "fired_mask pointer error", ESP_ERR_INVALID_ARG);
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    GPIO_ENTER_CRITICAL();
+    if (gpio_wait_any_state.waiting != NULL && gpio_wait_any_state.waiting != task) {
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO wait_any already has a waiting task");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (gpio_wait_any_state.mask != (uint32_t)mask || gpio_wait_any_state.mask_h != (uint32_t)(mask >> 32) ||
+        gpio_wait_any_state.task != task) {
+        uint64_t old_mask = ((uint64_t)gpio_wait_any_state.mask_h << 32) | gpio_wait_any_state.mask;
+        gpio_wait_any_state.task = task;
+        gpio_wait_any_state.fired = 0;
+        gpio_wait_any_state.fired_h = 0;
+        gpio_wait_any_state.mask = (uint32_t)mask;
+        gpio_wait_any_state.mask_h = (uint32_t)(mask >> 32);
+        gpio_intr_release(old_mask & ~mask);
+        for (uint64_t pins = mask; pins; pins &= pins - 1) {
+            uint32_t gpio_num = __builtin_ctzll(pins);
+            gpio_intr_enable_on_core(gpio_num, gpio_intr_core(gpio_num));
+        }
+    }
+    GPIO_EXIT_CRITICAL();
+
+    TimeOut_t time_out;
+    vTaskSetTimeOutState(&time_out);
+    bool armed = false;     // se publico waiting antes del ultimo ulTaskNotifyTake
+    bool took = false;      // el ultimo ulTaskNotifyTake consumio una notificacion
+    while (1) {
+        bool timed_out = (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE);
+
+        GPIO_ENTER_CRITICAL();
+        uint64_t fired = __atomic_exchange_n(&gpio_wait_any_state.fired, 0, __ATOMIC_ACQUIRE);
+        fired |= (uint64_t)__atomic_exchange_n(&gpio_wait_any_state.fired_h, 0, __ATOMIC_ACQUIRE) << 32;
+        // Si waiting ya no esta, el ISR o gpio_wait_any_cancel lo tomo y hay exactamente una
+        // notificacion para esta tarea (la del ISR ya se entrego; la de cancel puede ir en camino)
+        bool given = armed && gpio_wait_any_state.waiting == NULL;
+        bool cancelled = (gpio_wait_any_state.task != task);
+        bool wait = (fired == 0 && !timed_out && !cancelled);
+        gpio_wait_any_state.waiting = wait ? task : NULL;
+        GPIO_EXIT_CRITICAL();
+
+        if (given && !took) {
+            // La notificacion llego despues de que ulTaskNotifyTake vencio: se consume aqui
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        if (!wait) {
+            *fired_mask = fired;
+            if (fired) {
+                return ESP_OK;
+            }
+            return cancelled ? ESP_ERR_INVALID_STATE : ESP_ERR_TIMEOUT;
+        }
+        armed = true;
+        took = (ulTaskNotifyTake(pdTRUE, timeout) != 0);
+    }
+}
+/**************************************************************************
+* Function: gpio_wait_any_cancel
+* Overview: Quita el registro de gpio_wait_any: el ISR deja de acumular y de notificar, y se
+* 			deshabilita la interrupcion de los pines que no tienen otro usuario. Si una tarea
+* 			esta bloqueada en gpio_wait_any, regresa con ESP_ERR_INVALID_STATE. Debe llamarse
+* 			antes de borrar la tarea que usa gpio_wait_any.
+*
+*****************************************************************************/
+
+void gpio_wait_any_cancel(void)
+{
+    GPIO_ENTER_CRITICAL();
+    uint64_t old_mask = ((uint64_t)gpio_wait_any_state.mask_h << 32) | gpio_wait_any_state.mask;
+    TaskHandle_t waiter = gpio_wait_any_state.waiting;
+    gpio_wait_any_state.mask = 0;
+    gpio_wait_any_state.mask_h = 0;
+    gpio_wait_any_state.fired = 0;
+    gpio_wait_any_state.fired_h = 0;
+    gpio_wait_any_state.task = NULL;
+    gpio_wait_any_state.waiting = NULL;
+    gpio_intr_release(old_mask);
+    GPIO_EXIT_CRITICAL();
+
+    // La tarea vio waiting en NULL y espera esta notificacion antes de regresar
+    if (waiter != NULL) {
+        xTaskNotifyGive(waiter);
+    }
+}
+/**************************************************************************
+* Function: gpio_coalesce_flush
+* Overview: Callback del timer de un grupo (tarea de esp_timer). Toma el lote acumulado, lo deja
+* 			vacio y lo entrega al callback del grupo.
+* Input: arg: Grupo de coalescencia.
+*
+*****************************************************************************/
+
+static void gpio_coalesce_flush(void *arg)
+{
+    gpio_coalesce_group_t *group = (gpio_coalesce_group_t *)arg;
+    gpio_coalesce_batch_t batch;
+
+    GPIO_ENTER_CRITICAL();
+    batch = group->batch;
+    memset(&group->batch, 0, sizeof(group->batch));
+    // Un grupo que se esta quitando ya no entrega lotes
+    gpio_coalesce_cb_t callback = (group->mask != 0) ? group->callback : NULL;
+    void *callback_arg = group->arg;
+    group->flushing = (batch.total != 0 && callback != NULL);
+    GPIO_EXIT_CRITICAL();
+
+    if (group->flushing) {
+        callback(&batch, callback_arg);
+        __atomic_store_n(&group->flushing, false, __ATOMIC_RELEASE);
+    }
+}
+/**************************************************************************
+* Function: gpio_coalesce_group_add
+* Preconditions: gpio_install_isr_service y tipo de interrupcion configurado en los pines
+* Overview: Crea un grupo de coalescencia con los pines de la mascara (un solo pin para modo por
+* 			pin) y habilita su interrupcion. Los eventos del grupo se entregan juntos en un lote
+* 			window_us despues del primero, o antes si el lote llega a max_events.
+* Input: mask: Mascara de 64 bits con los pines del grupo.
+* 		 window_us: Duracion de la ventana en microsegundos.
+* 		 max_events: Eventos que adelantan la entrega, 0 sin limite.
+* 		 callback: Funcion que recibe el lote, se ejecuta en la tarea de esp_timer.
+* 		 arg: parametro para el callback.
+* 		 group_id: Donde se guarda el identificador del grupo.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado
+* 		  ESP_ERR_NO_MEM: No quedan grupos libres o no se pudo crear el timer
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_coalesce_group_add(uint64_t mask, uint32_t window_us, uint32_t max_events,
+                                  gpio_coalesce_cb_t callback, void *arg, int *group_id)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(mask != 0 && (mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(window_us > 0 && callback != NULL && group_id != NULL, "GPIO coalesce config error", ESP_ERR_INVALID_ARG);
+
+    esp_timer_handle_t timer = NULL;
+    int id = -1;
+    GPIO_ENTER_CRITICAL();
+    if ((gpio_context.coalesce_mask & mask) == 0) {
+        for (int i = 0; i < CONFIG_GPIO_COALESCE_GROUPS; i++) {
+            if (gpio_coalesce[i].mask == 0 && gpio_coalesce[i].callback == NULL) {
+                id = i;
+                gpio_coalesce[i].callback = callback;   // reserva el grupo
+                break;
+            }
+        }
+    }
+    GPIO_EXIT_CRITICAL();
+    GPIO_CHECK(id >= 0, "GPIO coalesce pins already grouped or no free group", ESP_ERR_NO_MEM);
+
+    gpio_coalesce_group_t *group = &gpio_coalesce[id];
+    const esp_timer_create_args_t timer_args = {
+        .callback = gpio_coalesce_flush,
+        .arg = group,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "gpio_coalesce",
+    };
+    if (esp_timer_create(&timer_args, &timer) != ESP_OK) {
+        GPIO_ENTER_CRITICAL();
+        group->callback = NULL;
+        GPIO_EXIT_CRITICAL();
+        ESP_LOGE(GPIO_TAG, "GPIO coalesce timer create failed");
+        return ESP_ERR_NO_MEM;
+    }
+
+    GPIO_ENTER_CRITICAL();
+    group->window_us = window_us;
+    group->max_events = max_events;
+    group->arg = arg;
+    group->timer = timer;
+    memset(&group->batch, 0, sizeof(group->batch));
+    group->mask = mask;
+    gpio_context.coalesce_mask |= mask;
+    for (uint64_t pins = mask; pins; pins &= pins - 1) {
+        uint32_t gpio_num = __builtin_ctzll(pins);
+        gpio_intr_enable_on_core(gpio_num, gpio_intr_core(gpio_num));
+    }
+    GPIO_EXIT_CRITICAL();
+    *group_id = id;
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_coalesce_group_remove
+* Overview: Quita un grupo de coalescencia. El lote pendiente se descarta y se deshabilita la
+* 			interrupcion de los pines sin otro usuario. Si el callback del grupo esta corriendo,
+* 			espera a que termine, asi que no debe llamarse desde el propio callback.
+* Input: group_id: Identificador devuelto por gpio_coalesce_group_add.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_coalesce_group_remove(int group_id)
+{
+    GPIO_CHECK(group_id >= 0 && group_id < CONFIG_GPIO_COALESCE_GROUPS, "GPIO coalesce group error", ESP_ERR_INVALID_ARG);
+    gpio_coalesce_group_t *group = &gpio_coalesce[group_id];
+
+    // El timer se reclama en la misma seccion critica en que se limpia la mascara: de dos
+    // llamadas concurrentes solo una lo borra. La mascara puede estar ya vacia si
+    // gpio_reset_mask quito todos los pines del grupo
+    GPIO_ENTER_CRITICAL();
+    esp_timer_handle_t timer = group->timer;
+    uint64_t mask = group->mask;
+    group->timer = NULL;
+    gpio_context.coalesce_mask &= ~mask;
+    group->mask = 0;
+    gpio_intr_release(mask);
+    GPIO_EXIT_CRITICAL();
+    GPIO_CHECK(timer != NULL, "GPIO coalesce group error", ESP_ERR_INVALID_ARG);
+
+    // Sin pines en el grupo ningun ISR nuevo arranca el timer y el flush ya no llama al
+    // callback; se espera al ISR que leyo la mascara vieja y a una entrega que ya estaba en curso
+    gpio_isr_chain_sync();
+    esp_timer_stop(timer);
+    while (__atomic_load_n(&group->flushing, __ATOMIC_ACQUIRE)) {
+        vTaskDelay(1);
+    }
+    esp_timer_delete(timer);
+    GPIO_ENTER_CRITICAL();
+    group->callback = NULL;
+    memset(&group->batch, 0, sizeof(group->batch));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_debounce_expire
+* Overview: Callback del timer compartido de antirrebote (tarea de esp_timer). Lee el nivel de
+* 			los pines vencidos, entrega presion o liberacion a los que cambiaron y reprograma el
+* 			timer al siguiente vencimiento.
+* Input: arg: No se usa.
+*
+*****************************************************************************/
+
+static void gpio_debounce_expire(void *arg)
+{
+    int64_t now = esp_timer_get_time();
+    int64_t next = 0;
+    uint64_t due = 0;
+
+    GPIO_ENTER_CRITICAL();
+    for (uint64_t armed = gpio_debounce.armed; armed; armed &= armed - 1) {
+        uint32_t gpio_num = __builtin_ctzll(armed);
+        if (gpio_debounce.deadline[gpio_num] <= now) {
+            due |= BIT64(gpio_num);
+        } else if (next == 0 || gpio_debounce.deadline[gpio_num] < next) {
+            next = gpio_debounce.deadline[gpio_num];
+        }
+    }
+    gpio_debounce.armed &= ~due;
+    gpio_debounce.timer_deadline = next;
+    uint64_t levels = gpio_hal_get_levels(gpio_context.gpio_hal);
+    uint64_t changed = (levels ^ gpio_debounce.state) & due;
+    gpio_debounce.state ^= changed;
+    uint64_t pressed = levels ^ gpio_debounce.active_low;
+    GPIO_EXIT_CRITICAL();
+
+    if (next != 0) {
+        esp_timer_start_once(gpio_debounce.timer, next - now);
+    }
+
+    for (; changed; changed &= changed - 1) {
+        uint32_t gpio_num = __builtin_ctzll(changed);
+        gpio_debounce_cb_t callback = gpio_debounce.callback[gpio_num];
+        if (callback != NULL) {
+            callback((gpio_num_t)gpio_num,
+                     (pressed & BIT64(gpio_num)) ? GPIO_DEBOUNCE_PRESS : GPIO_DEBOUNCE_RELEASE,
+                     gpio_debounce.arg[gpio_num]);
+        }
+    }
+}
+/**************************************************************************
+* Function: gpio_debounce_add
+* Preconditions: gpio_install_isr_service y pin configurado como entrada
+* Overview: Agrega antirrebote por timer al pin: pone su interrupcion en ambos flancos y entrega
+* 			un evento de presion o liberacion cuando el nivel se mantiene stable_us sin cambiar.
+* 			Todos los pines comparten un solo esp_timer.
+* Input: gpio_num: Numero de GPIO.
+* 		 stable_us: Tiempo en microsegundos que el nivel debe mantenerse.
+* 		 active_low: true si el boton se presiona en nivel bajo.
+* 		 callback: Funcion que recibe los eventos, se ejecuta en la tarea de esp_timer.
+* 		 arg: parametro para el callback.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado
+* 		  ESP_ERR_NO_MEM: No se pudo crear el timer
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_debounce_add(gpio_num_t gpio_num, uint32_t stable_us, bool active_low,
+                            gpio_debounce_cb_t callback, void *arg)
+{
+    GPIO_CHECK(gpio_context.gpio_isr_func != NULL, "GPIO isr service is not installed, call gpio_install_isr_service() first", ESP_ERR_INVALID_STATE);
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(stable_us > 0 && callback != NULL, "GPIO debounce config error", ESP_ERR_INVALID_ARG);
+
+    if (gpio_debounce.timer == NULL) {
+        esp_timer_handle_t timer = NULL;
+        const esp_timer_create_args_t timer_args = {
+            .callback = gpio_debounce_expire,
+            .arg = NULL,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "gpio_debounce",
+        };
+        GPIO_CHECK(esp_timer_create(&timer_args, &timer) == ESP_OK, "GPIO debounce timer create failed", ESP_ERR_NO_MEM);
+        GPIO_ENTER_CRITICAL();
+        if (gpio_debounce.timer == NULL) {
+            gpio_debounce.timer = timer;
+            timer = NULL;
+        }
+        GPIO_EXIT_CRITICAL();
+        if (timer != NULL) {
+            esp_timer_delete(timer);
+        }
+    }
+
+    gpio_set_intr_type(gpio_num, GPIO_INTR_ANYEDGE);
+    GPIO_ENTER_CRITICAL();
+    gpio_debounce.stable_us[gpio_num] = stable_us;
+    gpio_debounce.callback[gpio_num] = callback;
+    gpio_debounce.arg[gpio_num] = arg;
+    gpio_debounce.armed &= ~BIT64(gpio_num);
+    if (active_low) {
+        gpio_debounce.active_low |= BIT64(gpio_num);
+    } else {
+        gpio_debounce.active_low &= ~BIT64(gpio_num);
+    }
+    // El nivel actual es el punto de partida: no se reporta como evento
+    if (gpio_hal_get_level(gpio_context.gpio_hal, gpio_num)) {
+        gpio_debounce.state |= BIT64(gpio_num);
+    } else {
+        gpio_debounce.state &= ~BIT64(gpio_num);
+    }
+    gpio_context.debounce_mask |= BIT64(gpio_num);
+    gpio_intr_enable_on_core(gpio_num, gpio_intr_core(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_debounce_remove
+* Overview: Quita el antirrebote del pin. Un vencimiento pendiente del pin se descarta y la
+* 			interrupcion del pin se deshabilita si no tiene otro usuario.
+* Input: gpio_num: Numero de GPIO.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_debounce_remove(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_context.debounce_mask &= ~BIT64(gpio_num);
+    gpio_debounce.armed &= ~BIT64(gpio_num);
+    gpio_debounce.callback[gpio_num] = NULL;
+    gpio_debounce.arg[gpio_num] = NULL;
+    gpio_intr_release(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_debounce_get_pressed
+* Overview: Devuelve los pines con antirrebote que estan presionados segun su ultimo nivel
+* 			estable.
+* Output: Mascara de 64 bits con los pines presionados.
+*
+*****************************************************************************/
+
+uint64_t gpio_debounce_get_pressed(void)
+{
+    GPIO_ENTER_CRITICAL();
+    uint64_t pressed = (gpio_debounce.state ^ gpio_debounce.active_low) & gpio_context.debounce_mask;
+    GPIO_EXIT_CRITICAL();
+    return pressed;
+}
+/**************************************************************************
+* Function: gpio_scan_tick
+* Overview: Callback del timer periodico del muestreo (tarea de esp_timer). Lee todo el puerto
+* 			y avanza los contadores verticales de todos los pines con unas cuantas operaciones
+* 			de bits. Publica el estado y acumula los pines que cambiaron.
+* Input: arg: No se usa.
+*
+*****************************************************************************/
+
+static void gpio_scan_tick(void *arg)
+{
+    uint64_t sample = gpio_hal_get_levels(gpio_context.gpio_hal);
+
+    GPIO_ENTER_CRITICAL();
+    // Los pines iguales a su estado reinician su contador; los distintos cuentan hacia abajo
+    // (3, 2, 1, 0) y cambian de estado en la cuarta muestra, cuando el contador da la vuelta
+    uint64_t delta = (sample ^ gpio_scan.state) & gpio_scan.mask;
+    gpio_scan.ct0 = ~(gpio_scan.ct0 & delta);
+    gpio_scan.ct1 = gpio_scan.ct0 ^ (gpio_scan.ct1 & delta);
+    uint64_t toggle = delta & gpio_scan.ct0 & gpio_scan.ct1;
+    gpio_scan.state ^= toggle;
+    gpio_scan.changed |= toggle;
+    uint64_t state = gpio_scan.state;
+    gpio_scan_cb_t callback = gpio_scan.callback;
+    void *callback_arg = gpio_scan.arg;
+    GPIO_EXIT_CRITICAL();
+
+    if (toggle != 0 && callback != NULL) {
+        callback(state, toggle, callback_arg);
+    }
+}
+/**************************************************************************
+* Function: gpio_scan_start
+* Preconditions: Pines configurados como entrada
+* Overview: Arranca el antirrebote por muestreo de los pines de la mascara. Un pin cambia de
+* 			estado despues de 4 muestras seguidas con el nuevo nivel, es decir, entre 3 y 4
+* 			periodos de muestreo. Convive con gpio_get_level, que sigue leyendo el nivel crudo.
+* Input: mask: Mascara de 64 bits con los pines a muestrear.
+* 		 period_us: Periodo de muestreo en microsegundos.
+* 		 callback: Funcion que recibe el estado y los pines que cambiaron en cada tick con
+* 		 		   cambios (tarea de esp_timer), puede ser NULL.
+* 		 arg: parametro para el callback.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El muestreo ya esta corriendo
+* 		  ESP_ERR_NO_MEM: No se pudo crear el timer
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_scan_start(uint64_t mask, uint32_t period_us, gpio_scan_cb_t callback, void *arg)
+{
+    GPIO_CHECK(mask != 0 && (mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(period_us > 0, "GPIO scan period error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(gpio_scan.timer == NULL, "GPIO scan already started", ESP_ERR_INVALID_STATE);
+
+    esp_timer_handle_t timer = NULL;
+    const esp_timer_create_args_t timer_args = {
+        .callback = gpio_scan_tick,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "gpio_scan",
+    };
+    GPIO_CHECK(esp_timer_create(&timer_args, &timer) == ESP_OK, "GPIO scan timer create failed", ESP_ERR_NO_MEM);
+
+    // El nivel actual es el estado inicial; los contadores empiezan llenos
+    uint64_t levels = gpio_hal_get_levels(gpio_context.gpio_hal);
+    GPIO_ENTER_CRITICAL();
+    gpio_scan.mask = mask;
+    gpio_scan.state = levels & mask;
+    gpio_scan.ct0 = ~0ULL;
+    gpio_scan.ct1 = ~0ULL;
+    gpio_scan.changed = 0;
+    gpio_scan.callback = callback;
+    gpio_scan.arg = arg;
+    gpio_scan.timer = timer;
+    GPIO_EXIT_CRITICAL();
+
+    esp_timer_start_periodic(timer, period_us);
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_scan_stop
+* Overview: Detiene el antirrebote por muestreo y libera su timer.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El muestreo no esta corriendo
+*
+*****************************************************************************/
+
+esp_err_t gpio_scan_stop(void)
+{
+    GPIO_CHECK(gpio_scan.timer != NULL, "GPIO scan not started", ESP_ERR_INVALID_STATE);
+    esp_timer_stop(gpio_scan.timer);
+    esp_timer_delete(gpio_scan.timer);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_scan.timer = NULL;
+    gpio_scan.mask = 0;
+    gpio_scan.callback = NULL;
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_scan_read
+* Overview: Devuelve el estado sin rebote de los pines muestreados y los que cambiaron desde la
+* 			lectura anterior; la mascara de cambios se limpia.
+* Input: state: Donde se guarda el estado sin rebote, puede ser NULL.
+* 		 changed: Donde se guardan los pines que cambiaron, puede ser NULL.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El muestreo no esta corriendo
+*
+*****************************************************************************/
+
+esp_err_t gpio_scan_read(uint64_t *state, uint64_t *changed)
+{
+    GPIO_CHECK(gpio_scan.timer != NULL, "GPIO scan not started", ESP_ERR_INVALID_STATE);
+
+    GPIO_ENTER_CRITICAL();
+    if (state != NULL) {
+        *state = gpio_scan.state;
+    }
+    if (changed != NULL) {
+        *changed = gpio_scan.changed;
+        gpio_scan.changed = 0;
+    }
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+#if CONFIG_GPIO_ISR_STATS
+/**************************************************************************
+* Function: gpio_isr_stats_get
+* Overview: Copia las estadisticas de un pin sin deshabilitar interrupciones: si el ISR
+* 			actualizo la entrada durante la copia, la copia se repite.
+* Input: gpio_num: Numero de GPIO.
+* 		 stats: Apuntador donde se guarda la copia.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_stats_get(gpio_num_t gpio_num, gpio_isr_pin_stats_t *stats)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(stats != NULL, "stats pointer error", ESP_ERR_INVALID_ARG);
+    gpio_isr_stats_entry_t *entry = &gpio_isr_stats[gpio_num];
+    uint32_t seq;
+    bool reset;
+    do {
+        seq = __atomic_load_n(&entry->seq, __ATOMIC_ACQUIRE);
+        *stats = entry->stats;
+        reset = entry->reset;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 0x1) || seq != __atomic_load_n(&entry->seq, __ATOMIC_RELAXED));
+
+    if (reset) {
+        *stats = (gpio_isr_pin_stats_t) {0};
+    }
+    stats->avg_cycles = stats->count ? (uint32_t)(stats->total_cycles / stats->count) : 0;
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_isr_stats_reset
+* Overview: Pide reiniciar las estadisticas de los pines de la mascara. El ISR reinicia la
+* 			entrada en el siguiente evento del pin; hasta entonces gpio_isr_stats_get la
+* 			reporta en cero.
+* Input: mask: Mascara de 64 bits con los pines a reiniciar.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_stats_reset(uint64_t mask)
+{
+    GPIO_CHECK((mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+    while (mask) {
+        uint32_t gpio_num = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        __atomic_store_n(&gpio_isr_stats[gpio_num].reset, 1, __ATOMIC_RELEASE);
+    }
+    return ESP_OK;
+}
+#endif
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+void gpio_uninstall_isr_service(void)
+{
+    gpio_isr_func_t *gpio_isr_func_free = NULL;
+    gpio_isr_handle_t gpio_isr_handle_free[portNUM_PROCESSORS];
+    if (gpio_context.gpio_isr_func == NULL) {
+        return;
+    }
+
+    // Los servicios que usan la interrupcion se quitan primero: despiertan a sus tareas y
+    // detienen sus timers
+    gpio_event_queue_uninstall();
+    gpio_wait_any_cancel();
+    for (int i = 0; i < CONFIG_GPIO_COALESCE_GROUPS; i++) {
+        if (gpio_coalesce[i].timer != NULL) {
+            gpio_coalesce_group_remove(i);
+        }
+    }
+    GPIO_ENTER_CRITICAL();
+    gpio_context.debounce_mask = 0;
+    gpio_debounce.armed = 0;
+    gpio_debounce.timer_deadline = 0;
+    memset(gpio_debounce.callback, 0, sizeof(gpio_debounce.callback));
+    memset(gpio_debounce.arg, 0, sizeof(gpio_debounce.arg));
+    GPIO_EXIT_CRITICAL();
+    if (gpio_debounce.timer != NULL) {
+        esp_timer_stop(gpio_debounce.timer);
+    }
+
+    GPIO_ENTER_CRITICAL();
+    if (gpio_context.gpio_isr_func == NULL) {
+        GPIO_EXIT_CRITICAL();
+        return;
+    }
+    gpio_isr_func_free = gpio_context.gpio_isr_func;
+    gpio_context.gpio_isr_func = NULL;
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        gpio_isr_handle_free[i] = gpio_context.gpio_isr_handle[i];
+        gpio_context.gpio_isr_handle[i] = NULL;
+    }
+    gpio_context.intr_affinity_mask = 0;
+    gpio_context.deferred_mask = 0;
+    gpio_context.deferred_masked_mask = 0;
+    gpio_context.isr_core_id = GPIO_ISR_CORE_ID_UNINIT;
+    GPIO_EXIT_CRITICAL();
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        if (gpio_isr_handle_free[i] != NULL) {
+            esp_intr_free(gpio_isr_handle_free[i]);
+        }
+    }
+    // Un ISR que ya estaba recorriendo una lista puede seguir usando sus nodos
+    gpio_isr_chain_sync();
+    GPIO_ENTER_CRITICAL();
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        gpio_isr_chain[i] = NULL;
+    }
+    for (int i = 0; i < CONFIG_GPIO_ISR_CHAIN_POOL_SIZE; i++) {
+        gpio_isr_chain_pool[i].in_use = false;
+    }
+    GPIO_EXIT_CRITICAL();
+#if CONFIG_GPIO_ISR_STATIC_TABLE
+    // La interrupcion ya se libero: se limpia la tabla para la siguiente instalacion
+    memset(gpio_isr_func_free, 0, sizeof(gpio_isr_func_table));
+#else
+    free(gpio_isr_func_free);
+#endif
+    return;
+}
+
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static void gpio_isr_register_on_core_static(void *param)
+{
+    gpio_isr_alloc_t *p = (gpio_isr_alloc_t *)param;
+    //We need to check the return value.
+    p->ret = esp_intr_alloc(p->source, p->intr_alloc_flags, p->fn, p->arg, p->handle);
+}
+/**************************************************************************
+* Function: gpio_isr_register_on_core
+* Overview: Reserva la interrupcion del GPIO en el nucleo indicado (por IPC si no es el nucleo
+* 			que llama).
+* Input: fn, arg, intr_alloc_flags, handle: Igual que en esp_intr_alloc.
+* 		 core_id: Nucleo donde se reserva la interrupcion.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_NOT_FOUND: No se encontro una interrupcion libre
+*
+*****************************************************************************/
+
+static esp_err_t gpio_isr_register_on_core(void (*fn)(void *), void *arg, int intr_alloc_flags, gpio_isr_handle_t *handle, uint32_t core_id)
+{
+    gpio_isr_alloc_t p;
+    p.source = ETS_GPIO_INTR_SOURCE;
+    p.intr_alloc_flags = intr_alloc_flags;
+    p.fn = fn;
+    p.arg = arg;
+    p.handle = handle;
+    esp_err_t ret;
+#if CONFIG_FREERTOS_UNICORE
+    gpio_isr_register_on_core_static(&p);
+    ret = ESP_OK;
+#else /* CONFIG_FREERTOS_UNICORE */
+    ret = esp_ipc_call_blocking(core_id, gpio_isr_register_on_core_static, (void *)&p);
+#endif /* !CONFIG_FREERTOS_UNICORE */
+    if (ret != ESP_OK) {
+        ESP_LOGE(GPIO_TAG, "esp_ipc_call_blocking failed (0x%x)", ret);
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (p.ret != ESP_OK) {
+        ESP_LOGE(GPIO_TAG, "esp_intr_alloc failed (0x%x)", p.ret);
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_isr_register(void (*fn)(void *), void *arg, int intr_alloc_flags, gpio_isr_handle_t *handle)
+{
+    GPIO_CHECK(fn, "GPIO ISR null", ESP_ERR_INVALID_ARG);
+    // Solo se toma el spinlock la primera vez, cuando el nucleo aun no esta asignado
+    if (gpio_context.isr_core_id == GPIO_ISR_CORE_ID_UNINIT) {
+        GPIO_ENTER_CRITICAL();
+        if(gpio_context.isr_core_id == GPIO_ISR_CORE_ID_UNINIT) {
+            gpio_context.isr_core_id = xPortGetCoreID();
+        }
+        GPIO_EXIT_CRITICAL();
+    }
+    return gpio_isr_register_on_core(fn, arg, intr_alloc_flags, handle, gpio_context.isr_core_id);
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = ESP_OK;
+
+    if ((intr_type == GPIO_INTR_LOW_LEVEL) || (intr_type == GPIO_INTR_HIGH_LEVEL)) {
+#if SOC_RTCIO_WAKE_SUPPORTED
+        if (rtc_gpio_is_valid_gpio(gpio_num)) {
+            ret = rtc_gpio_wakeup_enable(gpio_num, intr_type);
+        }
+#endif
+        GPIO_ENTER_CRITICAL();
+        gpio_hal_set_intr_type(gpio_context.gpio_hal, gpio_num, intr_type);
+        gpio_hal_wakeup_enable(gpio_context.gpio_hal, gpio_num);
+#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
+        gpio_hal_sleep_sel_dis(gpio_context.gpio_hal, gpio_num);
+        gpio_iomux_invalidate(BIT64(gpio_num));
+#endif
+        GPIO_EXIT_CRITICAL();
+    } else {
+        ESP_LOGE(GPIO_TAG, "GPIO wakeup only supports level mode, but edge mode set. gpio_num:%u", gpio_num);
+        ret = ESP_ERR_INVALID_ARG;
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = ESP_OK;
+#if SOC_RTCIO_WAKE_SUPPORTED
+    if (rtc_gpio_is_valid_gpio(gpio_num)) {
+        ret = rtc_gpio_wakeup_disable(gpio_num);
+    }
+#endif
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_wakeup_disable(gpio_context.gpio_hal, gpio_num);
+#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
+    gpio_hal_sleep_sel_en(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+#endif
+    GPIO_EXIT_CRITICAL();
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_set_drive_capability(gpio_num_t gpio_num, gpio_drive_cap_t strength)
+{
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(strength < GPIO_DRIVE_CAP_MAX, "GPIO drive capability error", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = ESP_OK;
+
+    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        GPIO_ENTER_CRITICAL();
+        gpio_iomux_modify(gpio_num, FUN_DRV, ((uint32_t)strength << FUN_DRV_S) & FUN_DRV);
+        GPIO_EXIT_CRITICAL();
+    } else {
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        ret = rtc_gpio_set_drive_capability(gpio_num, strength);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_get_drive_capability(gpio_num_t gpio_num, gpio_drive_cap_t *strength)
+{
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(strength != NULL, "GPIO drive capability pointer error", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = ESP_OK;
+
+    if (!rtc_gpio_is_valid_gpio(gpio_num) || SOC_GPIO_SUPPORT_RTC_INDEPENDENT) {
+        *strength = (gpio_drive_cap_t)((gpio_iomux_get(gpio_num) & FUN_DRV) >> FUN_DRV_S);
+    } else {
+#if SOC_RTCIO_INPUT_OUTPUT_SUPPORTED
+        ret = rtc_gpio_get_drive_capability(gpio_num, strength);
+#else
+        abort(); // This should be eliminated as unreachable, unless a programming error has occured
+#endif
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: gpio_get_pad_config
+* Overview: Funcion que obtiene la palabra de configuracion IOMUX de un pin (funcion, entrada,
+* 			pullup, pulldown, drive, campos de sleep). Con CONFIG_GPIO_IOMUX_SHADOW se sirve
+* 			de la copia en DRAM sin acceder al hardware.
+* Input: gpio_num: Numero de GPIO.
+* 		 pad_config: Apuntador donde se guarda la palabra.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_get_pad_config(gpio_num_t gpio_num, uint32_t *pad_config)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(pad_config != NULL, "GPIO pad config pointer error", ESP_ERR_INVALID_ARG);
+    *pad_config = gpio_iomux_get(gpio_num);
+    return ESP_OK;
+}
+
+#if CONFIG_GPIO_IOMUX_SHADOW
+/**************************************************************************
+* Function: gpio_iomux_shadow_verify
+* Overview: Funcion que compara la copia IOMUX en DRAM con los registros reales de los pines
+* 			de la mascara. Los pines que aun no estan en la copia no se comparan.
+* Input: mask: Mascara de 64 bits con los pines a revisar.
+* 		 drift_mask: Apuntador donde se guardan los pines que difieren (puede ser NULL).
+* Output: ESP_OK: Sin diferencias
+* 		  ESP_ERR_INVALID_STATE: Algun pin difiere del hardware
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_iomux_shadow_verify(uint64_t mask, uint64_t *drift_mask)
+{
+    GPIO_CHECK((mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+    uint64_t drift = 0;
+
+    GPIO_ENTER_CRITICAL();
+    uint64_t pins = mask & gpio_context.iomux_shadow_valid;
+    while (pins) {
+        uint32_t io_num = __builtin_ctzll(pins);
+        pins &= pins - 1;
+        if (gpio_hal_iomux_read(GPIO_PIN_MUX_REG[io_num]) != gpio_context.iomux_shadow[io_num]) {
+            drift |= BIT64(io_num);
+        }
+    }
+    GPIO_EXIT_CRITICAL();
+
+    if (drift_mask) {
+        *drift_mask = drift;
+    }
+    return drift ? ESP_ERR_INVALID_STATE : ESP_OK;
+}
+/**************************************************************************
+* Function: gpio_iomux_shadow_sync
+* Overview: Funcion que vuelve a cargar desde el hardware la copia IOMUX de los pines de la
+* 			mascara, por ejemplo despues de que gpio_iomux_shadow_verify reporte diferencias.
+* Input: mask: Mascara de 64 bits con los pines a recargar.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_iomux_shadow_sync(uint64_t mask)
+{
+    GPIO_CHECK((mask & ~SOC_GPIO_VALID_GPIO_MASK) == 0, "GPIO_PIN mask error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_context.iomux_shadow_valid &= ~mask;
+    uint64_t pins = mask;
+    while (pins) {
+        gpio_iomux_load(__builtin_ctzll(pins));
+        pins &= pins - 1;
+    }
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+#endif
+
+#if CONFIG_GPIO_CRITICAL_STATS
+/**************************************************************************
+* Function: gpio_get_critical_count
+* Overview: Funcion que devuelve cuantas secciones criticas ha tomado el driver desde el
+* 			ultimo gpio_reset_critical_count. Leyendo el contador antes y despues de una
+* 			llamada se obtiene el costo en secciones criticas de esa API.
+* Output: Numero de secciones criticas
+*
+*****************************************************************************/
+uint32_t gpio_get_critical_count(void)
+{
+    return gpio_context.critical_count;
+}
+/**************************************************************************
+* Function: gpio_reset_critical_count
+* Overview: Funcion que pone en cero el contador de secciones criticas.
+*
+*****************************************************************************/
+void gpio_reset_critical_count(void)
+{
+    GPIO_ENTER_CRITICAL();
+    gpio_context.critical_count = 0;
+    GPIO_EXIT_CRITICAL();
+}
+#endif
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_hold_en(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "Only output-capable GPIO support this function", ESP_ERR_NOT_SUPPORTED);
+    int ret = ESP_OK;
+
+    if (rtc_gpio_is_valid_gpio(gpio_num)) {
+#if SOC_RTCIO_HOLD_SUPPORTED
+        ret = rtc_gpio_hold_en(gpio_num);
+#endif
+    } else if (GPIO_HOLD_MASK[gpio_num]) {
+        GPIO_ENTER_CRITICAL();
+        gpio_hal_hold_en(gpio_context.gpio_hal, gpio_num);
+        GPIO_EXIT_CRITICAL();
+    } else {
+        ret = ESP_ERR_NOT_SUPPORTED;
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_hold_dis(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "Only output-capable GPIO support this function", ESP_ERR_NOT_SUPPORTED);
+    int ret = ESP_OK;
+
+    if (rtc_gpio_is_valid_gpio(gpio_num)) {
+#if SOC_RTCIO_HOLD_SUPPORTED
+        ret = rtc_gpio_hold_dis(gpio_num);
+#endif
+    }else if (GPIO_HOLD_MASK[gpio_num]) {
+        GPIO_ENTER_CRITICAL();
+        gpio_hal_hold_dis(gpio_context.gpio_hal, gpio_num);
+        GPIO_EXIT_CRITICAL();
+    } else {
+        ret = ESP_ERR_NOT_SUPPORTED;
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+void gpio_deep_sleep_hold_en(void)
+{
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_deep_sleep_hold_en(gpio_context.gpio_hal);
+    GPIO_EXIT_CRITICAL();
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+void gpio_deep_sleep_hold_dis(void)
+{
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_deep_sleep_hold_dis(gpio_context.gpio_hal);
+    GPIO_EXIT_CRITICAL();
+}
+
+#if SOC_GPIO_SUPPORT_FORCE_HOLD
+
+esp_err_t IRAM_ATTR gpio_force_hold_all()
+{
+#if SOC_RTCIO_HOLD_SUPPORTED
+    rtc_gpio_force_hold_en_all();
+#endif
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_force_hold_all();
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
+esp_err_t IRAM_ATTR gpio_force_unhold_all()
+{
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_force_unhold_all();
+    GPIO_EXIT_CRITICAL();
+#if SOC_RTCIO_HOLD_SUPPORTED
+    rtc_gpio_force_hold_dis_all();
+#endif
+    return ESP_OK;
+}
+#endif
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+void gpio_iomux_in(uint32_t gpio, uint32_t signal_idx)
+{
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_iomux_in(gpio_context.gpio_hal, gpio, signal_idx);
+    gpio_iomux_invalidate(BIT64(gpio));
+    GPIO_EXIT_CRITICAL();
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+void gpio_iomux_out(uint8_t gpio_num, int func, bool oen_inv)
+{
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_iomux_out(gpio_context.gpio_hal, gpio_num, func, (uint32_t)oen_inv);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_pullup_en(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_pullup_en(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_pullup_dis(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_pullup_dis(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_pulldown_en(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_pulldown_en(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_pulldown_dis(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_pulldown_dis(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_input_disable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_input_disable(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_input_enable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_input_enable(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_output_disable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_output_disable(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+static esp_err_t gpio_sleep_output_enable(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_OUTPUT_GPIO(gpio_num), "GPIO output gpio_num error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_output_enable(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_sleep_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    if ((GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) != true) && (mode & GPIO_MODE_DEF_OUTPUT)) {
+        ESP_LOGE(GPIO_TAG, "io_num=%d can only be input", gpio_num);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+
+    if (mode & GPIO_MODE_DEF_INPUT) {
+        gpio_sleep_input_enable(gpio_num);
+    } else {
+        gpio_sleep_input_disable(gpio_num);
+    }
+
+    if (mode & GPIO_MODE_DEF_OUTPUT) {
+        gpio_sleep_output_enable(gpio_num);
+    } else {
+        gpio_sleep_output_disable(gpio_num);
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_sleep_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_CHECK(pull <= GPIO_FLOATING, "GPIO pull mode error", ESP_ERR_INVALID_ARG);
+    esp_err_t ret = ESP_OK;
+
+    switch (pull) {
+        case GPIO_PULLUP_ONLY:
+            gpio_sleep_pulldown_dis(gpio_num);
+            gpio_sleep_pullup_en(gpio_num);
+            break;
+
+        case GPIO_PULLDOWN_ONLY:
+            gpio_sleep_pulldown_en(gpio_num);
+            gpio_sleep_pullup_dis(gpio_num);
+            break;
+
+        case GPIO_PULLUP_PULLDOWN:
+            gpio_sleep_pulldown_en(gpio_num);
+            gpio_sleep_pullup_en(gpio_num);
+            break;
+
+        case GPIO_FLOATING:
+            gpio_sleep_pulldown_dis(gpio_num);
+            gpio_sleep_pullup_dis(gpio_num);
+            break;
+
+        default:
+            ESP_LOGE(GPIO_TAG, "Unknown pull up/down mode,gpio_num=%u,pull=%u", gpio_num, pull);
+            ret = ESP_ERR_INVALID_ARG;
+            break;
+    }
+
+    return ret;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_sleep_sel_en(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_sel_en(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+/**************************************************************************
+* Function: Nombre de la funci?n
+* Preconditions: Qu? funciones o declaraciones son previas al programa
+* Overview: resumen del programa.
+* Input: argumentos de entrada.
+* Output: argumentos de salida
+*
+*****************************************************************************/
+
+esp_err_t gpio_sleep_sel_dis(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_sel_dis(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+
+    return ESP_OK;
+}
+
+#if CONFIG_GPIO_ESP32_SUPPORT_SWITCH_SLP_PULL
+esp_err_t gpio_sleep_pupd_config_apply(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_pupd_config_apply(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
+esp_err_t gpio_sleep_pupd_config_unapply(gpio_num_t gpio_num)
+{
+    GPIO_CHECK(GPIO_IS_VALID_GPIO(gpio_num), "GPIO number error", ESP_ERR_INVALID_ARG);
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_sleep_pupd_config_unapply(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+#endif // CONFIG_GPIO_ESP32_SUPPORT_SWITCH_SLP_PULL
+
+#if SOC_GPIO_SUPPORT_DEEPSLEEP_WAKEUP
+esp_err_t gpio_deep_sleep_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    if (!gpio_hal_is_valid_deepsleep_wakeup_gpio(gpio_num)) {
+        ESP_LOGE(GPIO_TAG, "GPIO %d does not support deep sleep wakeup", gpio_num);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((intr_type != GPIO_INTR_LOW_LEVEL) && (intr_type != GPIO_INTR_HIGH_LEVEL)) {
+        ESP_LOGE(GPIO_TAG, "GPIO wakeup only supports level mode, but edge mode set. gpio_num:%u", gpio_num);
+        return ESP_ERR_INVALID_ARG;
+    }
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_deepsleep_wakeup_enable(gpio_context.gpio_hal, gpio_num, intr_type);
+#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
+    gpio_hal_sleep_sel_dis(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+#endif
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+
+esp_err_t gpio_deep_sleep_wakeup_disable(gpio_num_t gpio_num)
+{
+    if (!gpio_hal_is_valid_deepsleep_wakeup_gpio(gpio_num)) {
+        ESP_LOGE(GPIO_TAG, "GPIO %d does not support deep sleep wakeup", gpio_num);
+        return ESP_ERR_INVALID_ARG;
+    }
+    GPIO_ENTER_CRITICAL();
+    gpio_hal_deepsleep_wakeup_disable(gpio_context.gpio_hal, gpio_num);
+#if CONFIG_ESP_SLEEP_GPIO_RESET_WORKAROUND || CONFIG_PM_SLP_DISABLE_GPIO
+    gpio_hal_sleep_sel_en(gpio_context.gpio_hal, gpio_num);
+    gpio_iomux_invalidate(BIT64(gpio_num));
+#endif
+    GPIO_EXIT_CRITICAL();
+    return ESP_OK;
+}
+#endif // SOC_GPIO_SUPPORT_DEEPSLEEP_WAKEUP
+
+
+
@@ -13,6 +13,7 @@
 #include "soc/soc_caps.h"
 #include "hal/gpio_types.h"
 #include "esp_rom_gpio.h"
+#include "freertos/FreeRTOS.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +39,172 @@ typedef intr_handle_t gpio_isr_handle_t;
  */
 typedef void (*gpio_isr_t)(void *arg);
 
+/**
+ * @brief Clase de prioridad de la interrupcion de un pin
+ *
+ * Cuando varios pines estan pendientes en la misma entrada al ISR, se atienden primero los de
+ * la clase mas alta.
+ */
+typedef enum {
+    GPIO_INTR_PRIO_NORMAL = 0,  /*!< Clase por defecto */
+    GPIO_INTR_PRIO_HIGH,        /*!< Se atiende antes que NORMAL */
+    GPIO_INTR_PRIO_CRITICAL,    /*!< Se atiende antes que cualquier otro pin */
+    GPIO_INTR_PRIO_MAX,
+} gpio_intr_prio_t;
+
+/**
+ * @brief Banco de pines definido por el usuario
+ *
+ * Se inicializa con gpio_bank_init, que valida la mascara y precalcula las submascaras.
+ */
+typedef struct {
+    uint64_t mask;          /*!< Pines del banco, cada bit se asigna a un GPIO */
+    uint64_t output_mask;   /*!< Pines del banco con capacidad de salida */
+    uint64_t rtc_mask;      /*!< Pines del banco cuyas resistencias de pull se manejan desde RTC_IO */
+} gpio_bank_t;
+
+/**
+ * @brief Transaccion de configuracion de varios pines
+ *
+ * Los cambios se preparan con gpio_txn_set_* y se aplican juntos con gpio_txn_commit.
+ * Si un mismo campo se prepara dos veces para un pin, solo se aplica el ultimo valor.
+ */
+typedef struct {
+    uint64_t dir_mask;      /*!< Pines con direccion pendiente */
+    uint64_t pull_mask;     /*!< Pines con modo de pull pendiente */
+    uint64_t intr_mask;     /*!< Pines con tipo de interrupcion pendiente */
+    uint64_t drive_mask;    /*!< Pines con capacidad de drive pendiente */
+    struct {
+        uint8_t mode;       /*!< gpio_mode_t */
+        uint8_t pull;       /*!< gpio_pull_mode_t */
+        uint8_t intr_type;  /*!< gpio_int_type_t */
+        uint8_t drive;      /*!< gpio_drive_cap_t */
+    } pin[GPIO_NUM_MAX];
+} gpio_config_txn_t;
+
+/**
+ * @brief Estado guardado de un conjunto de pines
+ *
+ * Lo llena gpio_state_save y lo aplica gpio_state_restore. Las entradas de pin[] se guardan
+ * compactas: solo se usan las primeras popcount(mask) posiciones, en orden de numero de pin.
+ */
+typedef struct {
+    uint64_t mask;            /*!< Pines guardados */
+    uint64_t output_enable;   /*!< Habilitacion de salida de los pines guardados */
+    uint64_t output_level;    /*!< Nivel que se mandaba a cada salida */
+    uint64_t edge_mask;       /*!< Pines con interrupcion por flanco (limpieza del estado al entrar al ISR) */
+    struct {
+        uint32_t pad;         /*!< Registro IOMUX: funcion, entrada, pull, drive */
+        uint32_t pin;         /*!< Registro GPIO_PINn: open-drain, tipo y habilitacion de interrupcion */
+        uint32_t out_sel;     /*!< Enrutamiento de salida en la matriz GPIO */
+    } pin[GPIO_NUM_MAX];
+} gpio_state_t;
+
+/**
+ * @brief Marca de tiempo tomada una sola vez al entrar al servicio de ISR
+ *
+ * cycles es el contador de ciclos del CPU que atiende la interrupcion (resolucion de
+ * 1/frecuencia del CPU); la diferencia entre dos marcas del mismo CPU es valida mientras el
+ * contador no de mas de una vuelta. time_us es el tiempo de esp_timer en microsegundos.
+ */
+typedef struct {
+    uint32_t cycles;        /*!< Contador de ciclos del CPU */
+    int64_t time_us;        /*!< Tiempo en microsegundos desde el arranque */
+} gpio_isr_timestamp_t;
+
+/**
+ * @brief Handler diferido de interrupcion GPIO, se ejecuta en una tarea
+ *
+ * @param gpio_num Pin que genero la interrupcion
+ * @param timestamp Marca de tiempo tomada al entrar al ISR (la del ultimo evento si hubo varios)
+ * @param arg Datos registrados del usuario
+ */
+typedef void (*gpio_deferred_handler_t)(gpio_num_t gpio_num, const gpio_isr_timestamp_t *timestamp, void *arg);
+
+/**
+ * @brief Evento de interrupcion GPIO guardado por el servicio de ISR
+ *
+ * Lo escribe el ISR en la cola de eventos y lo entrega gpio_event_read.
+ */
+typedef struct {
+    uint8_t gpio_num;       /*!< Pin que genero la interrupcion */
+    uint8_t level;          /*!< Nivel del pin leido al entrar al ISR */
+    uint32_t cycles;        /*!< Contador de ciclos del CPU al entrar al ISR */
+    int64_t timestamp;      /*!< Tiempo en microsegundos (esp_timer_get_time) al entrar al ISR */
+} gpio_event_t;
+
+/// Numero de casillas del histograma de duracion de handlers; la ultima acumula todo lo mayor
+#define GPIO_ISR_STATS_HIST_BINS            (16)
+
+/**
+ * @brief Estadisticas de interrupcion de un pin (CONFIG_GPIO_ISR_STATS)
+ *
+ * Las duraciones estan en ciclos del CPU que atiende el pin. La casilla i de hist cuenta los
+ * handlers que tardaron de 2^i a 2^(i+1)-1 ciclos.
+ */
+typedef struct {
+    uint32_t count;             /*!< Veces que se llamo al handler del pin */
+    uint32_t coalesced;         /*!< Veces que se atendio junto con otros pines en la misma entrada al ISR */
+    uint32_t min_cycles;        /*!< Duracion minima del handler */
+    uint32_t max_cycles;        /*!< Duracion maxima del handler */
+    uint32_t avg_cycles;        /*!< Duracion promedio, la calcula gpio_isr_stats_get */
+    uint64_t total_cycles;      /*!< Suma de las duraciones */
+    uint32_t hist[GPIO_ISR_STATS_HIST_BINS]; /*!< Histograma log2 de duraciones */
+} gpio_isr_pin_stats_t;
+
+/**
+ * @brief Lote de eventos de un grupo de coalescencia
+ */
+typedef struct {
+    uint64_t pending_mask;          /*!< OR de los pines que dispararon durante la ventana */
+    uint32_t total;                 /*!< Eventos en el lote */
+    gpio_isr_timestamp_t first;     /*!< Marca de tiempo del primer evento */
+    gpio_isr_timestamp_t last;      /*!< Marca de tiempo del ultimo evento */
+    uint16_t count[GPIO_NUM_MAX];   /*!< Eventos de cada pin (se satura en UINT16_MAX) */
+} gpio_coalesce_batch_t;
+
+/**
+ * @brief Callback que recibe un lote de eventos, se ejecuta en la tarea de esp_timer
+ *
+ * @param batch Lote entregado, solo es valido durante la llamada
+ * @param arg Datos registrados del usuario
+ */
+typedef void (*gpio_coalesce_cb_t)(const gpio_coalesce_batch_t *batch, void *arg);
+
+/**
+ * @brief Evento entregado por el antirrebote
+ */
+typedef enum {
+    GPIO_DEBOUNCE_RELEASE = 0,      /*!< El pin se libero y se mantuvo estable */
+    GPIO_DEBOUNCE_PRESS,            /*!< El pin se presiono y se mantuvo estable */
+} gpio_debounce_event_t;
+
+/**
+ * @brief Callback del antirrebote, se ejecuta en la tarea de esp_timer
+ *
+ * @param gpio_num Pin que cambio
+ * @param event Presion o liberacion
+ * @param arg Datos registrados del usuario
+ */
+typedef void (*gpio_debounce_cb_t)(gpio_num_t gpio_num, gpio_debounce_event_t event, void *arg);
+
+/**
+ * @brief Callback del antirrebote por muestreo, se ejecuta en la tarea de esp_timer
+ *
+ * @param state Estado sin rebote de los pines muestreados
+ * @param changed Pines que cambiaron en este tick
+ * @param arg Datos registrados del usuario
+ */
+typedef void (*gpio_scan_cb_t)(uint64_t state, uint64_t changed, void *arg);
+
+/**
+ * @brief Contadores de la cola de eventos GPIO
+ */
+typedef struct {
+    uint32_t dropped;       /*!< Eventos descartados porque la cola estaba llena */
+    uint32_t high_water;    /*!< Maximo numero de eventos pendientes observado */
+} gpio_event_stats_t;
+
 /**************************************************************************
 * Function: gpio_config
 * Overview: Configuracion comun del GPIO.
@@ -103,8 +270,129 @@ esp_err_t gpio_set_input_pulldown(gpio_num_t gpio_num);
 *****************************************************************************/
 esp_err_t gpio_set_output(gpio_num_t gpio_num);
 /**************************************************************************
+* Function: gpio_bank_init
+* Overview: Inicializa un banco de pines: valida la mascara y precalcula las mascaras
+* 			de pines de salida y de pines RTC.
+* Input: bank: Descriptor del banco.
+* 		 mask: Mascara de 64 bits con los pines del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_init(gpio_bank_t *bank, uint64_t mask);
+/**************************************************************************
+* Function: gpio_bank_output_enable
+* Preconditions: gpio_bank_init
+* Overview: Activa como salida los pines del banco con capacidad de salida.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_output_enable(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_output_disable
+* Preconditions: gpio_bank_init
+* Overview: Desactiva como salida los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_output_disable(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_input_enable
+* Preconditions: gpio_bank_init
+* Overview: Activa como entrada los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_input_enable(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_input_disable
+* Preconditions: gpio_bank_init
+* Overview: Desactiva como entrada los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_input_disable(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_pullup_en
+* Preconditions: gpio_bank_init
+* Overview: Activa las resistencias de pullup de los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pullup_en(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_pullup_dis
+* Preconditions: gpio_bank_init
+* Overview: Desactiva las resistencias de pullup de los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pullup_dis(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_pulldown_en
+* Preconditions: gpio_bank_init
+* Overview: Activa las resistencias de pulldown de los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pulldown_en(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_pulldown_dis
+* Preconditions: gpio_bank_init
+* Overview: Desactiva las resistencias de pulldown de los pines del banco.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_pulldown_dis(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_reset
+* Preconditions: gpio_bank_init
+* Overview: Regresa todos los pines del banco a su estado inicial.
+* Input: bank: Descriptor del banco.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_reset(const gpio_bank_t *bank);
+/**************************************************************************
+* Function: gpio_bank_write
+* Preconditions: gpio_bank_init
+* Overview: Escribe el nivel de los pines de salida del banco.
+* Input: bank: Descriptor del banco.
+* 		 values: Mascara de 64 bits con el nivel deseado de cada pin.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_bank_write(const gpio_bank_t *bank, uint64_t values);
+/**************************************************************************
+* Function: gpio_bank_read
+* Preconditions: gpio_bank_init
+* Overview: Lee el nivel de todos los pines del banco en una sola muestra.
+* Input: bank: Descriptor del banco.
+* Output: Niveles de los pines del banco en su posicion de bit
+*
+*****************************************************************************/
+uint64_t gpio_bank_read(const gpio_bank_t *bank);
+/**************************************************************************
 * Function: gpio_act_left_op
-* Preconditions: gpio_hal_act_left_op
+* Preconditions: gpio_bank_output_enable
 * Overview: Funcion que activa el lado izquierdo del chip como salida.
 * Output: ret
 *
@@ -112,7 +400,7 @@ esp_err_t gpio_set_output(gpio_num_t gpio_num);
 esp_err_t gpio_act_left_op(void);
 /**************************************************************************
 * Function: gpio_deact_left_op
-* Preconditions: gpio_hal_deact_left_op
+* Preconditions: gpio_bank_output_disable
 * Overview: Funcion que desactiva el lado izquierdo del chip como salida.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -121,7 +409,7 @@ esp_err_t gpio_act_left_op(void);
 esp_err_t gpio_deact_left_op(void);
 /**************************************************************************
 * Function: gpio_act_right_op
-* Preconditions: gpio_hal_act_right_op
+* Preconditions: gpio_bank_output_enable
 * Overview: Funcion que activa el lado derecho del chip como salida.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -130,7 +418,7 @@ esp_err_t gpio_deact_left_op(void);
 esp_err_t gpio_act_right_op(void);
 /**************************************************************************
 * Function: gpio_deact_right_op
-* Preconditions: gpio_hal_deact_right_op
+* Preconditions: gpio_bank_output_disable
 * Overview: Funcion que desactiva el lado derecho del chip como salida.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -139,7 +427,7 @@ esp_err_t gpio_act_right_op(void);
 esp_err_t gpio_deact_right_op(void);
 /**************************************************************************
 * Function: gpio_act_left_ip
-* Preconditions: gpio_hal_act_left_ip
+* Preconditions: gpio_bank_input_enable
 * Overview: Funcion que activa el lado izquierdo del chip como entrada.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -148,7 +436,7 @@ esp_err_t gpio_deact_right_op(void);
 esp_err_t gpio_act_left_ip(void);
 /**************************************************************************
 * Function: gpio_deact_left_ip
-* Preconditions: gpio_hal_deact_left_ip
+* Preconditions: gpio_bank_input_disable
 * Overview: Funcion que desactiva el lado izquierdo del chip como entrada.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -157,7 +445,7 @@ esp_err_t gpio_act_left_ip(void);
 esp_err_t gpio_deact_left_ip(void);
 /**************************************************************************
 * Function: gpio_act_right_ip
-* Preconditions: gpio_hal_act_right_ip
+* Preconditions: gpio_bank_input_enable
 * Overview: Funcion que activa el lado derecho del chip como entrada.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -166,7 +454,7 @@ esp_err_t gpio_deact_left_ip(void);
 esp_err_t gpio_act_right_ip(void);
 /**************************************************************************
 * Function: gpio_deact_right_ip
-* Preconditions: gpio_hal_deact_right_ip
+* Preconditions: gpio_bank_input_disable
 * Overview: Funcion que desactiva el lado derecho del chip como entrada.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -175,7 +463,7 @@ esp_err_t gpio_act_right_ip(void);
 esp_err_t gpio_deact_right_ip(void);
 /**************************************************************************
  * Function: gpio_act_left_pulldown
- * Preconditions: gpio_hal_act_left_pulldown
+ * Preconditions: gpio_bank_pulldown_en
  * Overview: Funcion que activa las resistencias de pulldown del lado izquierdo del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -184,7 +472,7 @@ esp_err_t gpio_deact_right_ip(void);
 esp_err_t gpio_act_left_pulldown(void);
 /**************************************************************************
  * Function: gpio_deact_left_pulldown
- * Preconditions: gpio_hal_deact_left_pulldown
+ * Preconditions: gpio_bank_pulldown_dis
  * Overview: Funcion que desactiva las resistencias de pulldown del lado izquierdo del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -193,7 +481,7 @@ esp_err_t gpio_act_left_pulldown(void);
 esp_err_t gpio_deact_left_pulldown(void);
 /**************************************************************************
  * Function: gpio_act_right_pulldown
- * Preconditions: gpio_hal_act_right_pulldown
+ * Preconditions: gpio_bank_pulldown_en
  * Overview: Funcion que activa las resistencias de pulldown del lado derecho del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -202,7 +490,7 @@ esp_err_t gpio_deact_left_pulldown(void);
 esp_err_t gpio_act_right_pulldown(void);
 /**************************************************************************
  * Function: gpio_deact_right_pulldown
- * Preconditions: gpio_hal_deact_right_pulldown
+ * Preconditions: gpio_bank_pulldown_dis
  * Overview: Funcion que desactiva las resistencias de pulldown del lado derecho del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -211,7 +499,7 @@ esp_err_t gpio_act_right_pulldown(void);
 esp_err_t gpio_deact_right_pulldown(void);
 /**************************************************************************
  * Function: gpio_act_left_pullup
- * Preconditions: gpio_hal_act_left_pullup
+ * Preconditions: gpio_bank_pullup_en
  * Overview: Funcion que activa las resistencias de pullup del lado izquierdo del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -220,7 +508,7 @@ esp_err_t gpio_deact_right_pulldown(void);
 esp_err_t gpio_act_left_pullup(void);
 /**************************************************************************
  * Function: gpio_deact_left_pullup
- * Preconditions: gpio_hal_deact_left_pullup
+ * Preconditions: gpio_bank_pullup_dis
  * Overview: Funcion que desactiva las resistencias de pullup del lado izquierdo del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -229,7 +517,7 @@ esp_err_t gpio_act_left_pullup(void);
 esp_err_t gpio_deact_left_pullup(void);
 /**************************************************************************
  * Function: gpio_act_right_pullup
- * Preconditions: gpio_hal_act_right_pullup
+ * Preconditions: gpio_bank_pullup_en
  * Overview: Funcion que activa las resistencias de pullup del lado derecho del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -238,7 +526,7 @@ esp_err_t gpio_deact_left_pullup(void);
 esp_err_t gpio_act_right_pullup(void);
 /**************************************************************************
  * Function: gpio_deact_right_pullup
- * Preconditions: gpio_hal_deact_right_pullup
+ * Preconditions: gpio_bank_pullup_dis
  * Overview: Funcion que desactiva las resistencias de pullup del lado derecho del chip.
  * Output: ESP_OK: Exitoso
  *  	   ESP_ERR_INVALID_ARG: Error de parametro
@@ -247,6 +535,7 @@ esp_err_t gpio_act_right_pullup(void);
 esp_err_t gpio_deact_right_pullup(void);
 /**************************************************************************
 * Function: gpio_reset_right
+* Preconditions: gpio_reset_mask
 * Overview: Funcion que reinicia el lado derecho del chip.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -255,6 +544,7 @@ esp_err_t gpio_deact_right_pullup(void);
 esp_err_t gpio_reset_right(void);
 /**************************************************************************
 * Function: gpio_reset_left
+* Preconditions: gpio_reset_mask
 * Overview: Funcion que reinicia el lado izquierdo del chip.
 * Output: ESP_OK: Exitoso
 *  		  ESP_ERR_INVALID_ARG: Error de parametro
@@ -263,6 +553,104 @@ esp_err_t gpio_reset_right(void);
 esp_err_t gpio_reset_left(void);
 
 
+/**************************************************************************
+* Function: gpio_txn_begin
+* Overview: Inicia una transaccion de configuracion vacia.
+* Input: txn: Transaccion.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_begin(gpio_config_txn_t *txn);
+
+/**************************************************************************
+* Function: gpio_txn_set_direction
+* Preconditions: gpio_txn_begin
+* Overview: Prepara la direccion de un pin (igual que gpio_set_direction).
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 mode: Modo del pin.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_direction(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_mode_t mode);
+
+/**************************************************************************
+* Function: gpio_txn_set_pull_mode
+* Preconditions: gpio_txn_begin
+* Overview: Prepara el modo de pull de un pin (igual que gpio_set_pull_mode).
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 pull: Modo de pull.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_pull_mode(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_pull_mode_t pull);
+
+/**************************************************************************
+* Function: gpio_txn_set_intr_type
+* Preconditions: gpio_txn_begin
+* Overview: Prepara el tipo de interrupcion de un pin (igual que gpio_set_intr_type).
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 intr_type: Tipo de interrupcion.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_intr_type(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_int_type_t intr_type);
+
+/**************************************************************************
+* Function: gpio_txn_set_drive_capability
+* Preconditions: gpio_txn_begin
+* Overview: Prepara la capacidad de drive de un pin (igual que gpio_set_drive_capability).
+* Input: txn: Transaccion.
+* 		 gpio_num: Numero de GPIO.
+* 		 strength: Capacidad del pad.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_set_drive_capability(gpio_config_txn_t *txn, gpio_num_t gpio_num, gpio_drive_cap_t strength);
+
+/**************************************************************************
+* Function: gpio_txn_commit
+* Preconditions: gpio_txn_begin
+* Overview: Aplica todos los cambios preparados bajo una sola seccion critica,
+* 			escribiendo cada registro una sola vez y solo si cambia.
+* Input: txn: Transaccion.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_txn_commit(const gpio_config_txn_t *txn);
+
+/**************************************************************************
+* Function: gpio_state_save
+* Overview: Guarda la configuracion actual de los pines de la mascara: habilitacion y nivel de
+* 			salida, pad, tipo de interrupcion y enrutamiento de la matriz.
+* Input: mask: Mascara de 64 bits con los pines a guardar.
+* 		 state: Estructura donde se guarda el estado.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_state_save(uint64_t mask, gpio_state_t *state);
+
+/**************************************************************************
+* Function: gpio_state_restore
+* Preconditions: gpio_state_save
+* Overview: Regresa los pines al estado guardado. Solo se escriben los registros cuyo valor
+* 			actual es distinto del guardado.
+* Input: state: Estado guardado con gpio_state_save.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_state_restore(const gpio_state_t *state);
+
 /**************************************************************************
 * Function: gpio_reset_pin
 * Overview: Funcion que regresa el GPIO a su estado inicial.
@@ -274,6 +662,19 @@ esp_err_t gpio_reset_left(void);
 *****************************************************************************/
 esp_err_t gpio_reset_pin(gpio_num_t gpio_num);
 
+/**************************************************************************
+* Function: gpio_reset_mask
+* Overview: Funcion que regresa todos los GPIO de la mascara a su estado inicial en una sola pasada.
+* 			Mismo estado que gpio_reset_pin: entrada y salida deshabilitadas, pullup activo.
+* 			Los pines salen de los servicios que usan su interrupcion (handlers diferidos y
+* 			encadenados, cola de eventos, gpio_wait_any, coalescencia y antirrebote).
+* Input: mask: Mascara de 64 bits con los pines a reiniciar.
+* Output: ESP_OK: Exitoso
+*  		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_reset_mask(uint64_t mask);
+
 /**************************************************************************
 * Function: gpio_set_intr_type
 * Overview: Configuracion del tipo de interrupcion.
@@ -285,6 +686,19 @@ esp_err_t gpio_reset_pin(gpio_num_t gpio_num);
 *****************************************************************************/
 esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type);
 
+/**************************************************************************
+* Function: gpio_set_intr_priority
+* Overview: Asigna la clase de prioridad de la interrupcion del pin. Los pines CRITICAL se
+* 			atienden antes que los demas pendientes en la misma interrupcion, sin importar su
+* 			numero de pin.
+* Input: gpio_num: Numero de GPIO.
+* 		 prio: Clase de prioridad.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_set_intr_priority(gpio_num_t gpio_num, gpio_intr_prio_t prio);
+
 /**************************************************************************
 * Function: gpio_intr_enable
 * Overview: Funcion que habilita el modulo de interrupcion de GPIO.
@@ -316,6 +730,38 @@ esp_err_t gpio_intr_disable(gpio_num_t gpio_num);
 *****************************************************************************/
 esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
 
+/**************************************************************************
+* Function: gpio_set_mask
+* Overview: Pone en alto varias salidas a la vez (una escritura por registro).
+* Input: mask: Mascara de 64 bits, cada bit se asigna a un GPIO.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: La mascara incluye pines que no son de salida
+*
+*****************************************************************************/
+esp_err_t gpio_set_mask(uint64_t mask);
+
+/**************************************************************************
+* Function: gpio_clear_mask
+* Overview: Pone en bajo varias salidas a la vez (una escritura por registro).
+* Input: mask: Mascara de 64 bits, cada bit se asigna a un GPIO.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: La mascara incluye pines que no son de salida
+*
+*****************************************************************************/
+esp_err_t gpio_clear_mask(uint64_t mask);
+
+/**************************************************************************
+* Function: gpio_write_mask
+* Overview: Escribe el nivel de varias salidas a la vez, con a lo mas cuatro escrituras
+* 			de registro (out_w1ts/out_w1tc y out1_w1ts/out1_w1tc).
+* Input: mask: Mascara de 64 bits con los pines a modificar.
+* 		 values: Nivel deseado para cada pin de la mascara (1-alto, 0-bajo).
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: La mascara incluye pines que no son de salida
+*
+*****************************************************************************/
+esp_err_t gpio_write_mask(uint64_t mask, uint64_t values);
+
 /**************************************************************************
 * Function: gpio_get_level
 * Overview: Obtencion del nivel de entrada el GPIO.
@@ -326,6 +772,17 @@ esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
 *****************************************************************************/
 int gpio_get_level(gpio_num_t gpio_num);
 
+/**************************************************************************
+* Function: gpio_get_levels
+* Overview: Obtiene el nivel de entrada de varios GPIO en el mismo instante.
+* 			Se leen los registros in e in1 uno tras otro, asi todos los pines de la mascara
+* 			pertenecen a la misma muestra.
+* Input: mask: Mascara de 64 bits con los pines de interes.
+* Output: Nivel de entrada de los pines de la mascara (bit n = GPIO n), 0 para el resto
+*
+*****************************************************************************/
+uint64_t gpio_get_levels(uint64_t mask);
+
 /**************************************************************************
 * Function: gpio_set_direction
 * Overview: Configura la direccion del GPIO, como output_only, input_only, output_and_input.
@@ -442,11 +899,27 @@ esp_err_t gpio_install_isr_service(int intr_alloc_flags);
 
 /**************************************************************************
 * Function: gpio_uninstall_isr_service
-* Overview: Desinstala el driver del servicio de ISR del GPIO.
+* Overview: Desinstala el driver del servicio de ISR del GPIO. Quita tambien la cola de
+* 			eventos, gpio_wait_any, los grupos de coalescencia y el antirrebote; las tareas
+* 			bloqueadas en ellos regresan con ESP_ERR_INVALID_STATE.
 *
 *****************************************************************************/
 void gpio_uninstall_isr_service(void);
 
+/**************************************************************************
+* Function: gpio_install_isr_service_per_core
+* Overview: Instala el servicio de ISR en todos los nucleos. Cada nucleo lee solo su propio
+* 			registro de estado. Los pines se asignan a un nucleo con gpio_isr_handler_add_on_core;
+* 			los demas se atienden en el nucleo que llamo esta funcion.
+* Input: intr_alloc_flags: Las banderas usadas para colocar la interrupcion.
+* Output: ESP_OK: Exitoso
+*         ESP_ERR_NO_MEM: Memoria insuficiente para instalar este servicio
+*         ESP_ERR_INVALID_STATE: El servicio ya esta instalado
+*         ESP_ERR_NOT_FOUND: No se encontro una interrupcion libre en algun nucleo
+*
+*****************************************************************************/
+esp_err_t gpio_install_isr_service_per_core(int intr_alloc_flags);
+
 /**************************************************************************
 * Function: gpio_isr_handler_add
 * Overview: A?ade el handler para el ISR del pin GPIO correspondiente.
@@ -468,6 +941,44 @@ void gpio_uninstall_isr_service(void);
 *****************************************************************************/
 esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args);
 
+/**************************************************************************
+* Function: gpio_isr_handler_add_on_core
+* Overview: A?ade el handler del ISR del pin y enruta su interrupcion al nucleo indicado.
+* 			La afinidad se conserva en gpio_intr_enable/gpio_config hasta que se llame
+* 			gpio_isr_handler_add o gpio_isr_handler_remove para el pin. Los pines de la cola de
+* 			eventos deben quedar todos en el mismo nucleo.
+* Input: gpio_num: Numero del GPIO.
+* 		 isr_handler: Funcion del handler de ISR para el GPIO correspondiente.
+* 		 args: parametro para el handler del ISR.
+* 		 core_id: Nucleo que atiende la interrupcion del pin.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no esta instalado en ese nucleo
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_isr_handler_add_on_core(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args, uint32_t core_id);
+
+/**************************************************************************
+* Function: gpio_isr_handler_add_deferred
+* Overview: Registra para el pin un handler que se ejecuta en una tarea del driver de alta
+* 			prioridad y no dentro del ISR. El ISR solo guarda el pin pendiente y la marca de
+* 			tiempo, asi que un handler pesado (p. ej. leer el ADC) no agrega latencia a los demas
+* 			pines. Varios eventos del pin antes de que corra la tarea se atienden con una sola
+* 			llamada. Los pines por nivel quedan deshabilitados hasta que termina el handler.
+* 			Reemplaza el handler registrado con gpio_isr_handler_add; gpio_isr_handler_remove lo
+* 			quita.
+* Input: gpio_num: Numero del GPIO.
+* 		 handler: Funcion que se ejecuta en la tarea.
+* 		 args: parametro para el handler.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el servicio de ISR no se ha inicializado o
+* 		  						 el pin es de la cola de eventos y se atiende en otro nucleo
+* 		  ESP_ERR_NO_MEM: No se pudo crear la tarea de handlers diferidos
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_isr_handler_add_deferred(gpio_num_t gpio_num, gpio_deferred_handler_t handler, void *args);
+
 /**************************************************************************
 * Function: gpio_isr_handler_remove
 * Overview: Remueve el handler del ISR para el pin GPIO correspondiente.
@@ -479,6 +990,328 @@ esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void
 *****************************************************************************/
 esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num);
 
+/**************************************************************************
+* Function: gpio_isr_handler_chain_add
+* Overview: Agrega un handler adicional al pin; varios modulos pueden atender el mismo pin.
+* 			Los handlers encadenados se ejecutan despues del de gpio_isr_handler_add, de mayor a
+* 			menor prioridad. Los nodos salen de un arreglo estatico de
+* 			CONFIG_GPIO_ISR_CHAIN_POOL_SIZE entradas, sin usar el heap.
+* Input: gpio_num: Numero del GPIO.
+* 		 isr_handler: Funcion del handler de ISR.
+* 		 args: parametro para el handler del ISR.
+* 		 priority: Prioridad del handler, mayor se ejecuta antes.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el servicio de ISR no se ha inicializado o
+* 		  						 el pin es de la cola de eventos y se atiende en otro nucleo
+* 		  ESP_ERR_NO_MEM: No quedan nodos libres
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_isr_handler_chain_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args, uint8_t priority);
+
+/**************************************************************************
+* Function: gpio_isr_handler_chain_remove
+* Overview: Quita un handler encadenado del pin. Es seguro llamarla mientras el ISR se esta
+* 			ejecutando; regresa cuando ningun ISR puede seguir usando el handler.
+* Input: gpio_num: Numero del GPIO.
+* 		 isr_handler: Funcion del handler de ISR.
+* 		 args: parametro con el que se registro el handler.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el servicio de ISR no se ha inicializado
+* 		  ESP_ERR_NOT_FOUND: El handler no esta registrado en el pin
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_isr_handler_chain_remove(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args);
+
+/**************************************************************************
+* Function: gpio_isr_get_timestamp
+* Preconditions: Llamada desde un handler registrado con gpio_isr_handler_add
+* Overview: Devuelve la marca de tiempo que tomo el servicio de ISR al entrar, antes de atender
+* 			cualquier handler. Todos los handlers de una misma interrupcion reciben la misma marca.
+* Input: timestamp: Apuntador donde se guarda la marca.
+*
+*****************************************************************************/
+void gpio_isr_get_timestamp(gpio_isr_timestamp_t *timestamp);
+
+/**************************************************************************
+* Function: gpio_event_queue_install
+* Preconditions: gpio_install_isr_service y tipo de interrupcion configurado en los pines
+* Overview: Hace que el servicio de ISR guarde un evento {pin, nivel, tiempo} en la cola
+* 			de eventos por cada interrupcion de los pines de la mascara. La cola es de un solo
+* 			productor (el ISR) y un solo lector (una tarea); el ISR guarda los eventos sin
+* 			secciones criticas.
+* Input: mask: Mascara de 64 bits con los pines que generan eventos.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no se ha inicializado
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_event_queue_install(uint64_t mask);
+
+/**************************************************************************
+* Function: gpio_event_queue_uninstall
+* Overview: Deja de guardar eventos, descarta los pendientes y deshabilita la interrupcion de
+* 			los pines sin otro usuario. Una tarea bloqueada en gpio_event_read regresa con
+* 			ESP_ERR_INVALID_STATE.
+*
+*****************************************************************************/
+void gpio_event_queue_uninstall(void);
+
+/**************************************************************************
+* Function: gpio_event_read
+* Preconditions: gpio_event_queue_install
+* Overview: Saca el evento mas antiguo de la cola. Si la cola esta vacia la tarea se bloquea
+* 			hasta que llegue un evento o se cumpla el timeout. Solo una tarea debe leer la cola.
+* Input: event: Apuntador donde se guarda el evento.
+* 		 timeout: Tiempo maximo de espera en ticks (portMAX_DELAY para esperar siempre).
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_TIMEOUT: No llego ningun evento en el tiempo de espera
+* 		  ESP_ERR_INVALID_STATE: La cola no esta instalada, se quito durante la espera u otra
+* 		  						 tarea ya espera
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_event_read(gpio_event_t *event, TickType_t timeout);
+
+/**************************************************************************
+* Function: gpio_event_get_stats
+* Overview: Obtiene los contadores de desbordamiento de la cola de eventos.
+* Input: stats: Apuntador donde se guardan los contadores.
+* 		 reset: true para reiniciar los contadores despues de leerlos.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_event_get_stats(gpio_event_stats_t *stats, bool reset);
+
+/**************************************************************************
+* Function: gpio_intr_set_rate_limit
+* Overview: Protege contra tormentas de interrupciones. Si el pin genera mas de max_events
+* 			interrupciones en una ventana de window_us, el ISR deshabilita su interrupcion y
+* 			un timer la rearma despues de backoff_us. Si la tormenta sigue, la espera se
+* 			duplica en cada rearme (hasta 32 veces backoff_us). El rearme se reporta en el log.
+* Input: gpio_num: Numero del GPIO.
+* 		 max_events: Eventos permitidos por ventana, 0 para quitar el limite.
+* 		 window_us: Duracion de la ventana en microsegundos.
+* 		 backoff_us: Espera base antes de rearmar en microsegundos.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_NO_MEM: No se pudo crear el timer de rearme
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_intr_set_rate_limit(gpio_num_t gpio_num, uint32_t max_events, uint32_t window_us, uint32_t backoff_us);
+
+/**************************************************************************
+* Function: gpio_intr_get_throttled_mask
+* Overview: Obtiene los pines cuya interrupcion esta deshabilitada por el limite de eventos.
+* Output: Mascara de 64 bits con los pines deshabilitados.
+*
+*****************************************************************************/
+uint64_t gpio_intr_get_throttled_mask(void);
+
+/**************************************************************************
+* Function: gpio_intr_get_storm_count
+* Overview: Obtiene cuantas veces el limite de eventos deshabilito la interrupcion del pin.
+* Input: gpio_num: Numero del GPIO.
+* Output: Numero de tormentas.
+*
+*****************************************************************************/
+uint32_t gpio_intr_get_storm_count(gpio_num_t gpio_num);
+
+/**************************************************************************
+* Function: gpio_wait_edge
+* Preconditions: gpio_install_isr_service
+* Overview: Bloquea la tarea, sin usar CPU, hasta el siguiente flanco del pin. La tarea se
+* 			despierta con una notificacion directa desde el ISR, solo mientras esta bloqueada;
+* 			no consume ni deja otras notificaciones de la tarea. El pin puede tener otros
+* 			handlers o servicios, pero entonces su tipo de interrupcion debe ser ya edge; si no
+* 			tiene otro usuario, el tipo se cambia durante la espera y se restaura al regresar.
+* 			Solo una tarea puede esperar cada pin.
+* Input: gpio_num: Numero del GPIO.
+* 		 edge: GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE o GPIO_INTR_ANYEDGE.
+* 		 timeout: Tiempo maximo de espera en ticks (portMAX_DELAY para esperar siempre).
+* 		 timestamp: Donde se guarda la marca de tiempo tomada al entrar al ISR, puede ser NULL.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_TIMEOUT: No hubo flanco en el tiempo de espera
+* 		  ESP_ERR_INVALID_STATE: El servicio de ISR no esta instalado, otra tarea ya espera el
+* 		  						 pin o el pin esta en uso con otro tipo de interrupcion
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_wait_edge(gpio_num_t gpio_num, gpio_int_type_t edge, TickType_t timeout, gpio_isr_timestamp_t *timestamp);
+
+/**************************************************************************
+* Function: gpio_wait_any
+* Preconditions: gpio_install_isr_service y tipo de interrupcion configurado en los pines
+* Overview: Bloquea la tarea hasta que dispare cualquier pin de la mascara. Devuelve todos los
+* 			pines que dispararon desde la llamada anterior con la misma mascara, asi que no se
+* 			pierden flancos ocurridos mientras la tarea procesaba. Solo una tarea puede usarla.
+* Input: mask: Mascara de 64 bits con los pines a vigilar.
+* 		 timeout: Tiempo maximo de espera en ticks (portMAX_DELAY para esperar siempre).
+* 		 fired_mask: Donde se guardan los pines que dispararon.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_TIMEOUT: Ningun pin disparo en el tiempo de espera
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el servicio de ISR no se ha inicializado,
+* 		  						 otra tarea ya espera o se llamo gpio_wait_any_cancel
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_wait_any(uint64_t mask, TickType_t timeout, uint64_t *fired_mask);
+
+/**************************************************************************
+* Function: gpio_wait_any_cancel
+* Overview: Quita el registro de gpio_wait_any: el ISR deja de acumular y de notificar y se
+* 			deshabilita la interrupcion de los pines sin otro usuario. Una tarea bloqueada en
+* 			gpio_wait_any regresa con ESP_ERR_INVALID_STATE. Debe llamarse antes de borrar la
+* 			tarea que usa gpio_wait_any.
+*
+*****************************************************************************/
+void gpio_wait_any_cancel(void);
+
+/**************************************************************************
+* Function: gpio_coalesce_group_add
+* Preconditions: gpio_install_isr_service y tipo de interrupcion configurado en los pines
+* Overview: Agrupa los eventos de los pines de la mascara (uno o varios) y los entrega en un
+* 			solo lote: OR de pines, conteo por pin y marcas de tiempo del primero y del ultimo.
+* 			El lote se entrega window_us despues del primer evento, o antes si llega a
+* 			max_events, con una sola despertada de tarea por lote. Un pin solo puede estar en un
+* 			grupo y no debe tener handler de gpio_isr_handler_add, que se seguiria llamando en
+* 			cada flanco.
+* Input: mask: Mascara de 64 bits con los pines del grupo.
+* 		 window_us: Duracion de la ventana en microsegundos.
+* 		 max_events: Eventos que adelantan la entrega, 0 sin limite.
+* 		 callback: Funcion que recibe el lote (tarea de esp_timer).
+* 		 arg: parametro para el callback.
+* 		 group_id: Donde se guarda el identificador del grupo.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el servicio de ISR no se ha inicializado
+* 		  ESP_ERR_NO_MEM: No quedan grupos libres (CONFIG_GPIO_COALESCE_GROUPS) o no hay timer
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_coalesce_group_add(uint64_t mask, uint32_t window_us, uint32_t max_events,
+                                  gpio_coalesce_cb_t callback, void *arg, int *group_id);
+
+/**************************************************************************
+* Function: gpio_coalesce_group_remove
+* Overview: Quita un grupo de coalescencia, descarta su lote pendiente y deshabilita la
+* 			interrupcion de los pines sin otro usuario. Al regresar el callback del grupo ya no
+* 			se esta ejecutando ni se volvera a llamar; no debe llamarse desde el propio callback.
+* Input: group_id: Identificador devuelto por gpio_coalesce_group_add.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_coalesce_group_remove(int group_id);
+
+/**************************************************************************
+* Function: gpio_debounce_add
+* Preconditions: gpio_install_isr_service y pin configurado como entrada
+* Overview: Agrega antirrebote por timer al pin. Cada flanco reinicia la espera del pin y, si el
+* 			nivel se mantiene stable_us, se entrega un evento de presion o liberacion. No usa
+* 			tareas ni sondeo por pin: todos los pines comparten un solo esp_timer programado
+* 			al vencimiento mas cercano. Pone la interrupcion del pin en ambos flancos.
+* Input: gpio_num: Numero de GPIO.
+* 		 stable_us: Tiempo en microsegundos que el nivel debe mantenerse.
+* 		 active_low: true si el boton se presiona en nivel bajo.
+* 		 callback: Funcion que recibe los eventos (tarea de esp_timer).
+* 		 arg: parametro para el callback.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el servicio de ISR no se ha inicializado
+* 		  ESP_ERR_NO_MEM: No se pudo crear el timer
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_debounce_add(gpio_num_t gpio_num, uint32_t stable_us, bool active_low,
+                            gpio_debounce_cb_t callback, void *arg);
+
+/**************************************************************************
+* Function: gpio_debounce_remove
+* Overview: Quita el antirrebote del pin, descarta su espera pendiente y deshabilita la
+* 			interrupcion del pin si no tiene otro usuario.
+* Input: gpio_num: Numero de GPIO.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_debounce_remove(gpio_num_t gpio_num);
+
+/**************************************************************************
+* Function: gpio_debounce_get_pressed
+* Overview: Devuelve los pines con antirrebote que estan presionados segun su ultimo nivel
+* 			estable.
+* Output: Mascara de 64 bits con los pines presionados.
+*
+*****************************************************************************/
+uint64_t gpio_debounce_get_pressed(void);
+
+/**************************************************************************
+* Function: gpio_scan_start
+* Preconditions: Pines configurados como entrada
+* Overview: Antirrebote para muchos contactos. Muestrea todo el puerto (in/in1) como una palabra
+* 			de 64 bits a periodo fijo y aplica un contador vertical por pin, de modo que el
+* 			costo de cada tick no depende del numero de pines. Un pin cambia de estado despues
+* 			de 4 muestras seguidas con el nuevo nivel. No usa interrupciones y convive con
+* 			gpio_get_level, que sigue leyendo el nivel crudo.
+* Input: mask: Mascara de 64 bits con los pines a muestrear.
+* 		 period_us: Periodo de muestreo en microsegundos.
+* 		 callback: Funcion que recibe el estado y los cambios de cada tick con cambios
+* 		 		   (tarea de esp_timer), puede ser NULL.
+* 		 arg: parametro para el callback.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el muestreo ya esta corriendo
+* 		  ESP_ERR_NO_MEM: No se pudo crear el timer
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_scan_start(uint64_t mask, uint32_t period_us, gpio_scan_cb_t callback, void *arg);
+
+/**************************************************************************
+* Function: gpio_scan_stop
+* Overview: Detiene el antirrebote por muestreo.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el muestreo no esta corriendo
+*
+*****************************************************************************/
+esp_err_t gpio_scan_stop(void);
+
+/**************************************************************************
+* Function: gpio_scan_read
+* Overview: Devuelve el estado sin rebote de los pines muestreados y los que cambiaron desde la
+* 			lectura anterior; la mascara de cambios se limpia.
+* Input: state: Donde se guarda el estado sin rebote, puede ser NULL.
+* 		 changed: Donde se guardan los pines que cambiaron, puede ser NULL.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_STATE: Estado equivocado, el muestreo no esta corriendo
+*
+*****************************************************************************/
+esp_err_t gpio_scan_read(uint64_t *state, uint64_t *changed);
+
+#if CONFIG_GPIO_ISR_STATS
+/**************************************************************************
+* Function: gpio_isr_stats_get
+* Overview: Obtiene una copia consistente de las estadisticas de interrupcion de un pin sin
+* 			detener las interrupciones.
+* Input: gpio_num: Numero del GPIO.
+* 		 stats: Apuntador donde se guardan las estadisticas.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_isr_stats_get(gpio_num_t gpio_num, gpio_isr_pin_stats_t *stats);
+
+/**************************************************************************
+* Function: gpio_isr_stats_reset
+* Overview: Reinicia las estadisticas de interrupcion de los pines de la mascara.
+* Input: mask: Mascara de 64 bits con los pines.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_isr_stats_reset(uint64_t mask);
+#endif
+
 /**************************************************************************
 * Function: gpio_set_drive_capability
 * Overview: Configura la capacidad del pad drive.
@@ -501,6 +1334,60 @@ esp_err_t gpio_set_drive_capability(gpio_num_t gpio_num, gpio_drive_cap_t streng
 *****************************************************************************/
 esp_err_t gpio_get_drive_capability(gpio_num_t gpio_num, gpio_drive_cap_t *strength);
 
+/**************************************************************************
+* Function: gpio_get_pad_config
+* Overview: Obtiene la palabra de configuracion IOMUX del pin. Con CONFIG_GPIO_IOMUX_SHADOW
+* 			se lee de la copia en DRAM del driver.
+* Input: gpio_num: Numero del GPIO.
+* 		 pad_config: Palabra de configuracion del pad.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_get_pad_config(gpio_num_t gpio_num, uint32_t *pad_config);
+
+#if CONFIG_GPIO_IOMUX_SHADOW
+/**************************************************************************
+* Function: gpio_iomux_shadow_verify
+* Overview: Compara la copia IOMUX del driver con los registros reales.
+* Input: mask: Mascara de 64 bits con los pines a revisar.
+* 		 drift_mask: Pines cuya copia difiere del hardware (puede ser NULL).
+* Output: ESP_OK: Sin diferencias
+* 		  ESP_ERR_INVALID_STATE: Algun pin difiere del hardware
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_iomux_shadow_verify(uint64_t mask, uint64_t *drift_mask);
+
+/**************************************************************************
+* Function: gpio_iomux_shadow_sync
+* Overview: Recarga desde el hardware la copia IOMUX de los pines de la mascara.
+* Input: mask: Mascara de 64 bits con los pines a recargar.
+* Output: ESP_OK: Exitoso
+* 		  ESP_ERR_INVALID_ARG: Error de parametro
+*
+*****************************************************************************/
+esp_err_t gpio_iomux_shadow_sync(uint64_t mask);
+#endif
+
+#if CONFIG_GPIO_CRITICAL_STATS
+/**************************************************************************
+* Function: gpio_get_critical_count
+* Overview: Devuelve cuantas secciones criticas ha tomado el driver desde el ultimo reinicio.
+* 			La diferencia antes/despues de una llamada da el costo de esa API.
+* Output: Numero de secciones criticas
+*
+*****************************************************************************/
+uint32_t gpio_get_critical_count(void);
+
+/**************************************************************************
+* Function: gpio_reset_critical_count
+* Overview: Pone en cero el contador de secciones criticas.
+*
+*****************************************************************************/
+void gpio_reset_critical_count(void);
+#endif
+
 /**************************************************************************
 * Function: gpio_hold_en
 * Overview: Activa la funcion de mantener el pad